@@ -0,0 +1,173 @@
+#include "conv_hybrid.h"
+
+// Non uniform partitioned convolution without added latency
+//
+// The first 2B taps (B the base block size) are applied in direct form
+// through a ring buffer, so each output is available as soon as its input
+// sample is. The remaining taps are covered by conv_level instances with
+// partition sizes P = B, 2B, 4B, ... where the level of partition size P
+// covers the taps [2P, 4P), and the last level the taps from 2P to the
+// end. A level only needs input that is at least 2P samples old, which
+// leaves it a full period of P samples to compute each output period.
+//
+// Every level spreads the work of a period evenly over the P / B base
+// blocks of the period (see conv_level.cpp), so each base block costs the
+// direct head plus one Budget() of every level, Max_Step_Work() items,
+// instead of an occasional transform of the largest partition.
+
+conv_hybrid::conv_hybrid() : _base_size(0), _delay(0), _fill(0) {}
+
+void conv_hybrid::Configure(std::vector<double> const& taps, long delay,
+	long base_size)
+{
+	// Req: taps in ring_buffer order, the tap of the oldest sample first
+	// Prom: output is delayed by delay samples and no latency is added
+	// Prom: no allocation when taps, delay and base_size are unchanged,
+	// the stream state is cleared in any case
+	long taps_size = static_cast<long>(taps.size());
+	if (!fft_real::Valid_Size(2 * base_size) || base_size > (1L << 30))
+	{
+		throw config_error("Invalid base size, power of two [2, 2^30]");
+	}
+	if (taps_size < 1 || delay < 0 || delay > LONG_MAX / 2 - taps_size)
+	{
+		throw parameter_error("Invalid taps or delay");
+	}
+	if (base_size == _base_size && delay == _delay && taps == _taps)
+	{
+		Clear();
+		return;
+	}
+
+	// Natural order kernel including the delay
+	long kernel_size = taps_size + delay;
+	std::vector<double> kernel(kernel_size, 0.0);
+	for (long tap = 0; tap < taps_size; tap++)
+	{
+		kernel[delay + tap] = taps[taps_size - 1 - tap];
+	}
+	long head_size = std::min(2 * base_size, kernel_size);
+	std::vector<double> head_taps(kernel.rend() - head_size, kernel.rend());
+	std::vector<conv_level> levels;
+	long partition_size = base_size;
+	while (2 * partition_size < kernel_size)
+	{
+		long end = kernel_size;
+		if (4 * partition_size < kernel_size
+			&& partition_size <= LONG_MAX / 8)
+		{
+			end = 4 * partition_size;
+		}
+		conv_level level;
+		level.Configure(kernel, 2 * partition_size, end, partition_size,
+			base_size);
+		levels.push_back(level);
+		if (end == kernel_size) { break; }
+		partition_size *= 2;
+	}
+	_head.Configure(head_size, head_size, base_size);
+	_head_taps = std::move(head_taps);
+	_levels = std::move(levels);
+	_block.assign(base_size, 0.0);
+	_taps = taps;
+	_base_size = base_size;
+	_delay = delay;
+	Clear();
+
+	return;
+}
+
+void conv_hybrid::Clear()
+{
+	_head.Clear();
+	for (auto& level : _levels) { level.Clear(); }
+	_fill = 0;
+
+	return;
+}
+
+long conv_hybrid::Base_Size() const
+{
+	return _base_size;
+}
+
+long conv_hybrid::Levels() const
+{
+	return static_cast<long>(_levels.size());
+}
+
+long conv_hybrid::Max_Step_Work() const
+{
+	// Prom: items of work per base block, direct head multiply-adds plus
+	// the per base block budget of every level
+	long work = _base_size * static_cast<long>(_head_taps.size());
+	for (auto const& level : _levels) { work += level.Budget(); }
+
+	return work;
+}
+
+void conv_hybrid::Process(double const* block, long block_size,
+	double* output)
+{
+	// Req: Configure(...), block and output hold block_size samples
+	// Prom: no allocation
+	Process_Samples(block, block_size, output);
+
+	return;
+}
+
+void conv_hybrid::Process_Zeros(long size, double* output)
+{
+	// Req: Configure(...), output holds size samples
+	Process_Samples(nullptr, size, output);
+
+	return;
+}
+
+void conv_hybrid::Set_Isa(mac_isa isa)
+{
+	_head.Set_Isa(isa);
+
+	return;
+}
+
+void conv_hybrid::Process_Samples(double const* block, long block_size,
+	double* output)
+{
+	// Req: block == nullptr inserts zeros
+	long sample = 0;
+	while (sample < block_size)
+	{
+		long chunk = std::min(block_size - sample, _base_size - _fill);
+		if (block == nullptr)
+		{
+			_head.Insert_Zeros(chunk);
+			std::fill(_block.begin() + _fill, _block.begin() + _fill + chunk,
+				0.0);
+		}
+		else
+		{
+			_head.Insert_Block(block + sample, chunk);
+			std::copy(block + sample, block + sample + chunk,
+				_block.begin() + _fill);
+		}
+		_head.Process_Cycles(_head_taps, _head_taps, chunk, output + sample);
+		for (auto const& level : _levels)
+		{
+			double const* level_output = level.Output() + _fill;
+			for (long index = 0; index < chunk; index++)
+			{
+				output[sample + index] += level_output[index];
+			}
+		}
+		_fill += chunk;
+		sample += chunk;
+		if (_fill == _base_size)
+		{
+			for (auto& level : _levels) { level.Step(_block.data()); }
+			_fill = 0;
+		}
+	}
+
+	return;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>	// std::copy, std::fill, std::min
+#include <climits>
+#include <vector>
+
+#include "conv_level.h"
+#include "errors_custom.h"
+#include "ring_buffer.h"
+
+class conv_hybrid
+{
+private:
+	long _base_size;
+	long _delay;
+	long _fill;
+	std::vector<double> _taps;
+	std::vector<double> _head_taps;
+	std::vector<double> _block;
+	ring_buffer _head;
+	std::vector<conv_level> _levels;
+
+public:
+	conv_hybrid();
+
+public:
+	void Configure(std::vector<double> const& taps, long delay,
+		long base_size);
+	void Clear();
+	long Base_Size() const;
+	long Levels() const;
+	long Max_Step_Work() const;
+	void Process(double const* block, long block_size, double* output);
+	void Process_Zeros(long size, double* output);
+	void Set_Isa(mac_isa isa);
+
+private:
+	void Process_Samples(double const* block, long block_size,
+		double* output);
+};
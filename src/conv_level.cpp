@@ -0,0 +1,216 @@
+#include "conv_level.h"
+
+// One level of the non uniform partitioned convolution in conv_hybrid
+//
+// The level convolves the taps [offset, end) of a kernel, offset being
+// twice the partition size P, with partitions of P taps. Input arrives in
+// base blocks of B samples, P a multiple of B. At the start of period j
+// (samples [jP, (j + 1)P)) block j - 1 is complete; its spectrum is the
+// newest entry of the delay line, and the output of period j + 1 is the
+// inverse transform of the delay line spectra times the partition spectra.
+// Since the taps start at 2P, that output only depends on blocks j - 1 and
+// older, so the whole period j is available to compute it.
+//
+// Scheduling: the work of a period is a job of Job_Size() items in order,
+// the stages of the forward transform, one item per bin and partition of
+// the spectral products, the stages of the inverse transform and the copy
+// of the outputs. Each of the P / B base blocks of a period advances the
+// job by Budget() items, so the job completes by the end of the period and
+// every base block does the same amount of work.
+
+conv_level::conv_level() :
+	_partition_size(0), _partitions(0), _spectrum_size(0), _base_size(0),
+	_steps(0), _step(0), _budget(0), _phase(0), _stage(0), _cursor(0),
+	_head(0) {}
+
+void conv_level::Configure(std::vector<double> const& kernel, long offset,
+	long end, long partition_size, long base_size)
+{
+	// Req: kernel in natural order, the tap of the newest sample first
+	// Req: offset == 2 * partition_size, partition_size a multiple of
+	// base_size, both powers of two
+	long kernel_size = static_cast<long>(kernel.size());
+	if (base_size < 1 || partition_size < base_size
+		|| partition_size % base_size != 0
+		|| !fft_real::Valid_Size(2 * partition_size)
+		|| offset != 2 * partition_size || end <= offset || end > kernel_size)
+	{
+		throw config_error("Invalid convolution level");
+	}
+	long partitions = (end - offset + partition_size - 1) / partition_size;
+	_fft.Configure(2 * partition_size);
+	long spectrum_size = _fft.Spectrum_Size();
+	_taps_spectra.assign(partitions * spectrum_size, 0.0);
+	_segment.assign(2 * partition_size, 0.0);
+	for (long partition = 0; partition < partitions; partition++)
+	{
+		std::fill(_segment.begin(), _segment.end(), 0.0);
+		long first = offset + partition * partition_size;
+		long last = std::min(first + partition_size, end);
+		std::copy(kernel.begin() + first, kernel.begin() + last,
+			_segment.begin());
+		_fft.Forward(_segment.data(),
+			_taps_spectra.data() + partition * spectrum_size);
+	}
+	_delay_line.assign(partitions * spectrum_size, 0.0);
+	_input.assign(2 * partition_size, 0.0);
+	_next.assign(partition_size, 0.0);
+	_accum.assign(spectrum_size, 0.0);
+	_pending.assign(partition_size, 0.0);
+	_current.assign(partition_size, 0.0);
+	_partition_size = partition_size;
+	_partitions = partitions;
+	_spectrum_size = spectrum_size;
+	_base_size = base_size;
+	_steps = partition_size / base_size;
+	_budget = (Job_Size() + _steps - 1) / _steps;
+	Clear();
+
+	return;
+}
+
+void conv_level::Clear()
+{
+	std::fill(_delay_line.begin(), _delay_line.end(), 0.0);
+	std::fill(_input.begin(), _input.end(), 0.0);
+	std::fill(_next.begin(), _next.end(), 0.0);
+	std::fill(_pending.begin(), _pending.end(), 0.0);
+	std::fill(_current.begin(), _current.end(), 0.0);
+	_step = 0;
+	_head = 0;
+	_phase = 4;
+	_stage = 0;
+	_cursor = 0;
+
+	return;
+}
+
+double const* conv_level::Output() const
+{
+	// Prom: the level outputs of the base block being filled
+	return _current.data() + _step * _base_size;
+}
+
+void conv_level::Step(double const* base_block)
+{
+	// Req: base_block holds the base_size samples just completed
+	// Prom: no allocation, Budget() items of work
+	std::copy(base_block, base_block + _base_size,
+		_next.begin() + _step * _base_size);
+	_step++;
+	if (_step == _steps)
+	{
+		Advance(LONG_MAX);
+		std::swap(_pending, _current);
+		std::copy(_input.begin() + _partition_size, _input.end(),
+			_input.begin());
+		std::copy(_next.begin(), _next.end(),
+			_input.begin() + _partition_size);
+		_step = 0;
+		Start_Job();
+	}
+	Advance(_budget);
+
+	return;
+}
+
+long conv_level::Job_Size() const
+{
+	long transform = 0;
+	for (long stage = 0; stage < _fft.Stages(); stage++)
+	{
+		transform += _fft.Stage_Size(stage);
+	}
+
+	return 2 * transform + _partitions * (_spectrum_size / 2)
+		+ _partition_size;
+}
+
+long conv_level::Budget() const
+{
+	return _budget;
+}
+
+void conv_level::Start_Job()
+{
+	_head++;
+	if (_head == _partitions) { _head = 0; }
+	std::fill(_accum.begin(), _accum.end(), 0.0);
+	_phase = 0;
+	_stage = 0;
+	_cursor = 0;
+
+	return;
+}
+
+void conv_level::Advance(long budget)
+{
+	// Phases: 0 forward transform, 1 spectral products, 2 inverse
+	// transform, 3 output copy, 4 done
+	double* newest = _delay_line.data() + _head * _spectrum_size;
+	long bins = _spectrum_size / 2;
+	while (budget > 0 && _phase < 4)
+	{
+		long size = 0;
+		if (_phase == 0 || _phase == 2) { size = _fft.Stage_Size(_stage); }
+		else if (_phase == 1) { size = _partitions * bins; }
+		else { size = _partition_size; }
+		long items = std::min(budget, size - _cursor);
+		long begin = _cursor;
+		long end = _cursor + items;
+		if (_phase == 0)
+		{
+			_fft.Forward_Stage(_input.data(), newest, _stage, begin, end);
+		}
+		else if (_phase == 1)
+		{
+			long item = begin;
+			while (item < end)
+			{
+				long partition = item / bins;
+				long first = item - partition * bins;
+				long last = std::min(bins, first + end - item);
+				long slot = _head - partition;
+				if (slot < 0) { slot += _partitions; }
+				double const* x = _delay_line.data() + slot * _spectrum_size;
+				double const* h = _taps_spectra.data()
+					+ partition * _spectrum_size;
+				for (long bin = first; bin < last; bin++)
+				{
+					double x_re = x[2 * bin];
+					double x_im = x[2 * bin + 1];
+					double h_re = h[2 * bin];
+					double h_im = h[2 * bin + 1];
+					_accum[2 * bin] += x_re * h_re - x_im * h_im;
+					_accum[2 * bin + 1] += x_re * h_im + x_im * h_re;
+				}
+				item += last - first;
+			}
+		}
+		else if (_phase == 2)
+		{
+			_fft.Inverse_Stage(_accum.data(), _segment.data(), _stage, begin,
+				end);
+		}
+		else
+		{
+			std::copy(_segment.begin() + _partition_size + begin,
+				_segment.begin() + _partition_size + end,
+				_pending.begin() + begin);
+		}
+		_cursor = end;
+		budget -= items;
+		if (_cursor == size)
+		{
+			_cursor = 0;
+			_stage++;
+			if (_phase == 1 || _phase == 3 || _stage == _fft.Stages())
+			{
+				_phase++;
+				_stage = 0;
+			}
+		}
+	}
+
+	return;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>	// std::copy, std::fill, std::min, std::swap
+#include <climits>
+#include <vector>
+
+#include "errors_custom.h"
+#include "fft_real.h"
+
+class conv_level
+{
+private:
+	long _partition_size;
+	long _partitions;
+	long _spectrum_size;
+	long _base_size;
+	long _steps;
+	long _step;
+	long _budget;
+	long _phase;
+	long _stage;
+	long _cursor;
+	long _head;
+	std::vector<double> _taps_spectra;
+	std::vector<double> _delay_line;
+	std::vector<double> _input;
+	std::vector<double> _next;
+	std::vector<double> _accum;
+	std::vector<double> _segment;
+	std::vector<double> _pending;
+	std::vector<double> _current;
+	fft_real _fft;
+
+public:
+	conv_level();
+
+public:
+	void Configure(std::vector<double> const& kernel, long offset, long end,
+		long partition_size, long base_size);
+	void Clear();
+	double const* Output() const;
+	void Step(double const* base_block);
+	long Job_Size() const;
+	long Budget() const;
+
+private:
+	void Start_Job();
+	void Advance(long budget);
+};
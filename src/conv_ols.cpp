@@ -0,0 +1,163 @@
+#include "conv_ols.h"
+
+// Overlap-save
+//
+// Each block transforms Fft_Size() input samples, the last taps - 1 of the
+// previous block followed by Fft_Size() - taps + 1 new ones, multiplies by
+// the spectrum of the taps and keeps the Fft_Size() - taps + 1 outputs
+// that are not wrapped around by the circular convolution.
+//
+// The round off of the forward transform, product and inverse transform
+// grows with log2(Fft_Size()) instead of the number of taps, and stays
+// below the ne summation term firf_base::Error_Imp_Resp(...) reserves for
+// the direct form for every tap count the engine is selected for. The
+// result is not bitwise equal to the direct form.
+
+conv_ols::conv_ols() : _fft_size(0), _taps_size(0) {}
+
+void conv_ols::Configure(std::vector<double> const& taps, long output_size)
+{
+	// Req: taps in ring_buffer order, the tap of the oldest sample first
+	// Prom: no allocation or transform when taps and the selected fft size
+	// are unchanged
+	long taps_size = static_cast<long>(taps.size());
+	if (taps_size < 1 || output_size < 0)
+	{
+		throw parameter_error("Invalid taps or output size");
+	}
+	long fft_size = Optimal_Fft_Size(taps_size, output_size);
+	if (fft_size == _fft_size && taps == _taps) { return; }
+	_fft.Configure(fft_size);
+	_taps = taps;
+	_taps_size = taps_size;
+	_fft_size = fft_size;
+	_segment.assign(fft_size, 0.0);
+	_spectrum.assign(_fft.Spectrum_Size(), 0.0);
+	_taps_spectrum.assign(_fft.Spectrum_Size(), 0.0);
+	for (long tap = 0; tap < taps_size; tap++)
+	{
+		_segment[tap] = taps[taps_size - 1 - tap];
+	}
+	_fft.Forward(_segment.data(), _taps_spectrum.data());
+
+	return;
+}
+
+long conv_ols::Fft_Size() const
+{
+	return _fft_size;
+}
+
+void conv_ols::Convolve(double const* signal, long signal_size, long delay,
+	double* output, long output_size)
+{
+	// Req: Configure(...) with the taps and output_size
+	// Prom: output[t] = sum of taps applied to signal[t - delay - e], where
+	// e counts back from the newest tap, zero outside the signal
+	// Prom: no allocation
+	Zero_Fill(signal_size, delay, output, output_size);
+	Convolve_Blocks(signal, signal_size, delay, output, output_size, 0,
+		Blocks(signal_size, delay, output_size));
+
+	return;
+}
+
+long conv_ols::Blocks(long signal_size, long delay, long output_size) const
+{
+	// Req: Configure(...)
+	// Prom: number of blocks Convolve(...) computes, each block is
+	// independent of the others
+	long history = _taps_size - 1;
+	long step = _fft_size - history;
+	long conv_end = std::min(signal_size + history, output_size - delay);
+	if (conv_end <= 0) { return 0; }
+
+	return (conv_end + step - 1) / step;
+}
+
+void conv_ols::Convolve_Blocks(double const* signal, long signal_size,
+	long delay, double* output, long output_size, long first_block,
+	long last_block)
+{
+	// Req: Configure(...), blocks [first_block, last_block) of
+	// Blocks(signal_size, delay, output_size)
+	// Prom: writes only the outputs of those blocks, no allocation
+	long history = _taps_size - 1;
+	long step = _fft_size - history;
+	long conv_end = std::min(signal_size + history, output_size - delay);
+	long bins = _fft.Spectrum_Size() / 2;
+	for (long block_index = first_block; block_index < last_block;
+		block_index++)
+	{
+		// Input samples [block - history, block + step)
+		long block = block_index * step;
+		long first = block - history;
+		for (long index = 0; index < _fft_size; index++)
+		{
+			long sample = first + index;
+			_segment[index] = (sample >= 0 && sample < signal_size)
+				? signal[sample] : 0.0;
+		}
+		_fft.Forward(_segment.data(), _spectrum.data());
+		for (long bin = 0; bin < bins; bin++)
+		{
+			double a_re = _spectrum[2 * bin];
+			double a_im = _spectrum[2 * bin + 1];
+			double b_re = _taps_spectrum[2 * bin];
+			double b_im = _taps_spectrum[2 * bin + 1];
+			_spectrum[2 * bin] = a_re * b_re - a_im * b_im;
+			_spectrum[2 * bin + 1] = a_re * b_im + a_im * b_re;
+		}
+		_fft.Inverse(_spectrum.data(), _segment.data());
+		long block_size = std::min(step, conv_end - block);
+		std::copy(_segment.begin() + history,
+			_segment.begin() + history + block_size,
+			output + delay + block);
+	}
+
+	return;
+}
+
+void conv_ols::Zero_Fill(long signal_size, long delay, double* output,
+	long output_size) const
+{
+	// Prom: zeros the outputs before delay and after the convolution
+	long conv_end = std::min(signal_size + _taps_size - 1,
+		output_size - delay);
+	if (conv_end < 0) { conv_end = 0; }
+	std::fill(output, output + std::min(delay, output_size), 0.0);
+	std::fill(output + std::min(delay + conv_end, output_size),
+		output + output_size, 0.0);
+
+	return;
+}
+
+long conv_ols::Optimal_Fft_Size(long taps_size, long output_size)
+{
+	// Prom: the power of two minimizing blocks * fft_size * log2(fft_size)
+	// for output_size outputs, at least 2 * taps_size when any block is
+	// needed
+	long fft_size = 4;
+	while (fft_size < 2 * taps_size && fft_size < LONG_MAX / 8)
+	{
+		fft_size *= 2;
+	}
+	long best_size = fft_size;
+	double best_cost = -1.0;
+	long conv_size = std::max(output_size, 1L);
+	while (fft_size < LONG_MAX / 8)
+	{
+		long step = fft_size - taps_size + 1;
+		double blocks = std::ceil(static_cast<double>(conv_size) / step);
+		double cost = blocks * fft_size * std::log2(fft_size);
+		if (best_cost < 0.0 || cost < best_cost)
+		{
+			best_cost = cost;
+			best_size = fft_size;
+		}
+		if (blocks <= 1.0) { break; }
+		fft_size *= 2;
+	}
+
+	return best_size;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>	// std::copy, std::fill, std::min, std::max
+#include <climits>
+#include <cmath>		// std::log2
+#include <vector>
+
+#include "errors_custom.h"
+#include "fft_real.h"
+
+class conv_ols
+{
+private:
+	long _fft_size;
+	long _taps_size;
+	std::vector<double> _taps;
+	std::vector<double> _taps_spectrum;
+	std::vector<double> _segment;
+	std::vector<double> _spectrum;
+	fft_real _fft;
+
+public:
+	conv_ols();
+
+public:
+	void Configure(std::vector<double> const& taps, long output_size);
+	long Fft_Size() const;
+	void Convolve(double const* signal, long signal_size, long delay,
+		double* output, long output_size);
+	long Blocks(long signal_size, long delay, long output_size) const;
+	void Convolve_Blocks(double const* signal, long signal_size, long delay,
+		double* output, long output_size, long first_block, long last_block);
+	void Zero_Fill(long signal_size, long delay, double* output,
+		long output_size) const;
+	static long Optimal_Fft_Size(long taps_size, long output_size);
+};
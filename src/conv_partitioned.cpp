@@ -0,0 +1,166 @@
+#include "conv_partitioned.h"
+
+// Uniformly partitioned overlap-save
+//
+// The taps are split into partitions of _partition_size taps, each held as
+// the spectrum of a 2 * _partition_size transform. Every full block of
+// input is transformed once, over itself and the previous block, and kept
+// in a frequency domain delay line of _partitions spectra. The spectrum of
+// an output block is the sum of the delay line spectra times the partition
+// spectra, so each block costs one forward and one inverse transform of
+// 2 * _partition_size whatever the number of taps.
+//
+// An output block is available once its input block is complete, so the
+// output lags the input by exactly _partition_size samples.
+
+conv_partitioned::conv_partitioned() :
+	_partition_size(0), _partitions(0), _spectrum_size(0), _delay(0),
+	_fill(0), _head(0) {}
+
+void conv_partitioned::Configure(std::vector<double> const& taps, long delay,
+	long partition_size)
+{
+	// Req: taps in ring_buffer order, the tap of the oldest sample first
+	// Prom: output is delayed by delay samples besides the latency
+	// Prom: no allocation or transform when taps, delay and partition_size
+	// are unchanged, the stream state is cleared in any case
+	long taps_size = static_cast<long>(taps.size());
+	if (!Valid_Partition_Size(partition_size))
+	{
+		throw config_error("Invalid partition size, power of two [2, 2^30]");
+	}
+	if (taps_size < 1 || delay < 0 || delay > LONG_MAX - taps_size)
+	{
+		throw parameter_error("Invalid taps or delay");
+	}
+	if (partition_size == _partition_size && delay == _delay && taps == _taps)
+	{
+		Clear();
+		return;
+	}
+	long delayed_size = taps_size + delay;
+	long partitions = (delayed_size + partition_size - 1) / partition_size;
+	_fft.Configure(2 * partition_size);
+	long spectrum_size = _fft.Spectrum_Size();
+	_taps_spectra.assign(partitions * spectrum_size, 0.0);
+	_segment.assign(2 * partition_size, 0.0);
+	for (long partition = 0; partition < partitions; partition++)
+	{
+		std::fill(_segment.begin(), _segment.end(), 0.0);
+		for (long tap = 0; tap < partition_size; tap++)
+		{
+			// Delayed taps in natural order, newest sample first
+			long delayed = partition * partition_size + tap;
+			if (delayed >= delay && delayed < delayed_size)
+			{
+				_segment[tap] = taps[taps_size - 1 - (delayed - delay)];
+			}
+		}
+		_fft.Forward(_segment.data(),
+			_taps_spectra.data() + partition * spectrum_size);
+	}
+	_delay_line.assign(partitions * spectrum_size, 0.0);
+	_input.assign(2 * partition_size, 0.0);
+	_output.assign(partition_size, 0.0);
+	_accum.assign(spectrum_size, 0.0);
+	_taps = taps;
+	_partition_size = partition_size;
+	_partitions = partitions;
+	_spectrum_size = spectrum_size;
+	_delay = delay;
+	Clear();
+
+	return;
+}
+
+void conv_partitioned::Clear()
+{
+	std::fill(_delay_line.begin(), _delay_line.end(), 0.0);
+	std::fill(_input.begin(), _input.end(), 0.0);
+	std::fill(_output.begin(), _output.end(), 0.0);
+	_fill = 0;
+	_head = 0;
+
+	return;
+}
+
+long conv_partitioned::Partition_Size() const
+{
+	return _partition_size;
+}
+
+void conv_partitioned::Process(double const* block, long block_size,
+	double* output)
+{
+	// Req: Configure(...), block and output hold block_size samples
+	// Prom: output[n] is the filtered sample of the input _partition_size
+	// samples earlier, no allocation
+	for (long sample = 0; sample < block_size; sample++)
+	{
+		output[sample] = _output[_fill];
+		_input[_partition_size + _fill] = block[sample];
+		_fill++;
+		if (_fill == _partition_size) { Process_Partition(); }
+	}
+
+	return;
+}
+
+void conv_partitioned::Process_Zeros(long size, double* output)
+{
+	// Req: Configure(...), output holds size samples
+	for (long sample = 0; sample < size; sample++)
+	{
+		output[sample] = _output[_fill];
+		_input[_partition_size + _fill] = 0.0;
+		_fill++;
+		if (_fill == _partition_size) { Process_Partition(); }
+	}
+
+	return;
+}
+
+bool conv_partitioned::Valid_Partition_Size(long partition_size)
+{
+	if (partition_size >= 2 && partition_size <= (1L << 30)
+		&& fft_real::Valid_Size(2 * partition_size))
+	{
+		return true;
+	}
+	return false;
+}
+
+void conv_partitioned::Process_Partition()
+{
+	// Req: _input holds the previous and the current full block
+	double* newest = _delay_line.data() + _head * _spectrum_size;
+	_fft.Forward(_input.data(), newest);
+	std::fill(_accum.begin(), _accum.end(), 0.0);
+	long bins = _spectrum_size / 2;
+	for (long partition = 0; partition < _partitions; partition++)
+	{
+		long slot = _head - partition;
+		if (slot < 0) { slot += _partitions; }
+		double const* x = _delay_line.data() + slot * _spectrum_size;
+		double const* h = _taps_spectra.data() + partition * _spectrum_size;
+		for (long bin = 0; bin < bins; bin++)
+		{
+			double x_re = x[2 * bin];
+			double x_im = x[2 * bin + 1];
+			double h_re = h[2 * bin];
+			double h_im = h[2 * bin + 1];
+			_accum[2 * bin] += x_re * h_re - x_im * h_im;
+			_accum[2 * bin + 1] += x_re * h_im + x_im * h_re;
+		}
+	}
+	_fft.Inverse(_accum.data(), _segment.data());
+	std::copy(_segment.begin() + _partition_size, _segment.end(),
+		_output.begin());
+	std::copy(_input.begin() + _partition_size, _input.end(),
+		_input.begin());
+	_head++;
+	if (_head == _partitions) { _head = 0; }
+	_fill = 0;
+
+	return;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>	// std::copy, std::fill
+#include <climits>
+#include <vector>
+
+#include "errors_custom.h"
+#include "fft_real.h"
+
+class conv_partitioned
+{
+private:
+	long _partition_size;
+	long _partitions;
+	long _spectrum_size;
+	long _delay;
+	long _fill;
+	long _head;
+	std::vector<double> _taps;
+	std::vector<double> _taps_spectra;
+	std::vector<double> _delay_line;
+	std::vector<double> _input;
+	std::vector<double> _output;
+	std::vector<double> _accum;
+	std::vector<double> _segment;
+	fft_real _fft;
+
+public:
+	conv_partitioned();
+
+public:
+	void Configure(std::vector<double> const& taps, long delay,
+		long partition_size);
+	void Clear();
+	long Partition_Size() const;
+	void Process(double const* block, long block_size, double* output);
+	void Process_Zeros(long size, double* output);
+	static bool Valid_Partition_Size(long partition_size);
+
+private:
+	void Process_Partition();
+};
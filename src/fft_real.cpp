@@ -0,0 +1,259 @@
+#include "fft_real.h"
+
+// Layout
+//
+// A real signal of _size samples is transformed as a complex signal of
+// _size / 2 samples, even samples as real and odd samples as imaginary
+// parts, followed by a split into the _size / 2 + 1 non redundant bins of
+// the real transform. Spectra are interleaved (real, imaginary) pairs.
+// Twiddles are evaluated directly with std::cos and std::sin, not by
+// recurrence, so each twiddle is within e of the exact value and the
+// transform error grows with log2(_size).
+//
+// Both directions are split into Stages(): the reordering of the input,
+// one stage per radix-2 pass, and the split or scaling of the output.
+// Each stage is a range of independent items, so a transform can be
+// spread over several calls with Forward_Stage(...) and Inverse_Stage(...)
+// and gives the same result as Forward(...) and Inverse(...).
+
+fft_real::fft_real() : _size(0), _passes(0) {}
+
+fft_real::fft_real(long size) : fft_real()
+{
+	Configure(size);
+
+	return;
+}
+
+void fft_real::Configure(long size)
+{
+	// Prom: no allocation when size == Size()
+	if (!Valid_Size(size))
+	{
+		throw config_error("Invalid fft size, power of two [4, LONG_MAX / 4]");
+	}
+	if (size == _size) { return; }
+	long half = size / 2;
+	std::vector<long> bit_reverse(half, 0);
+	long bits = 0;
+	while ((1L << bits) < half) { bits++; }
+	for (long index = 0; index < half; index++)
+	{
+		long reversed = 0;
+		for (long bit = 0; bit < bits; bit++)
+		{
+			reversed |= ((index >> bit) & 1L) << (bits - 1 - bit);
+		}
+		bit_reverse[index] = reversed;
+	}
+	std::vector<double> twiddles(half, 0.0);
+	for (long index = 0; index < half / 2; index++)
+	{
+		double angle = -2.0 * PI_FIR * index / half;
+		twiddles[2 * index] = std::cos(angle);
+		twiddles[2 * index + 1] = std::sin(angle);
+	}
+	std::vector<double> real_twiddles(2 * (half + 1), 0.0);
+	for (long index = 0; index <= half; index++)
+	{
+		double angle = -PI_FIR * index / half;
+		real_twiddles[2 * index] = std::cos(angle);
+		real_twiddles[2 * index + 1] = std::sin(angle);
+	}
+	_bit_reverse = std::move(bit_reverse);
+	_twiddles = std::move(twiddles);
+	_real_twiddles = std::move(real_twiddles);
+	_work = std::vector<double>(size, 0.0);
+	_size = size;
+	_passes = bits;
+
+	return;
+}
+
+long fft_real::Size() const
+{
+	return _size;
+}
+
+long fft_real::Spectrum_Size() const
+{
+	// Prom: number of doubles in an interleaved spectrum
+	return _size + 2;
+}
+
+void fft_real::Forward(double const* signal, double* spectrum)
+{
+	// Req: signal holds Size() samples, spectrum holds Spectrum_Size()
+	// Prom: no allocation
+	for (long stage = 0; stage < Stages(); stage++)
+	{
+		Forward_Stage(signal, spectrum, stage, 0, Stage_Size(stage));
+	}
+
+	return;
+}
+
+void fft_real::Inverse(double const* spectrum, double* signal)
+{
+	// Req: spectrum holds Spectrum_Size(), signal holds Size() samples
+	// Prom: Inverse(Forward(signal)) reproduces signal, no allocation
+	for (long stage = 0; stage < Stages(); stage++)
+	{
+		Inverse_Stage(spectrum, signal, stage, 0, Stage_Size(stage));
+	}
+
+	return;
+}
+
+long fft_real::Stages() const
+{
+	return _passes + 2;
+}
+
+long fft_real::Stage_Size(long stage) const
+{
+	// Prom: number of items of stage, each of similar cost
+	long half = _size / 2;
+	if (stage == 0) { return half; }
+	if (stage <= _passes) { return half / 2; }
+
+	return half;
+}
+
+void fft_real::Forward_Stage(double const* signal, double* spectrum,
+	long stage, long begin, long end)
+{
+	// Req: stages in order, items [begin, end) of Stage_Size(stage)
+	// Req: signal and spectrum unchanged until the last stage
+	long half = _size / 2;
+	double* work = _work.data();
+	if (stage == 0)
+	{
+		for (long index = begin; index < end; index++)
+		{
+			long target = _bit_reverse[index];
+			work[2 * target] = signal[2 * index];
+			work[2 * target + 1] = signal[2 * index + 1];
+		}
+		return;
+	}
+	if (stage <= _passes)
+	{
+		Butterflies(stage - 1, begin, end, false);
+		return;
+	}
+
+	// Split into the even and odd sample spectra and combine, the item
+	// half also writes bin half
+	for (long bin = begin; bin < end; bin++)
+	{
+		for (long out = bin; out <= half; out += half)
+		{
+			long bin_k = (out == half) ? 0 : out;
+			long bin_c = (out == 0) ? 0 : half - out;
+			double k_re = work[2 * bin_k];
+			double k_im = work[2 * bin_k + 1];
+			double c_re = work[2 * bin_c];
+			double c_im = -work[2 * bin_c + 1];
+			double even_re = 0.5 * (k_re + c_re);
+			double even_im = 0.5 * (k_im + c_im);
+			double odd_re = 0.5 * (k_im - c_im);
+			double odd_im = -0.5 * (k_re - c_re);
+			double w_re = _real_twiddles[2 * out];
+			double w_im = _real_twiddles[2 * out + 1];
+			spectrum[2 * out] = even_re + w_re * odd_re - w_im * odd_im;
+			spectrum[2 * out + 1] = even_im + w_re * odd_im + w_im * odd_re;
+			if (out != 0) { break; }
+		}
+	}
+
+	return;
+}
+
+void fft_real::Inverse_Stage(double const* spectrum, double* signal,
+	long stage, long begin, long end)
+{
+	// Req: stages in order, items [begin, end) of Stage_Size(stage)
+	// Req: spectrum and signal unchanged until the last stage
+	long half = _size / 2;
+	double* work = _work.data();
+	if (stage == 0)
+	{
+		for (long bin = begin; bin < end; bin++)
+		{
+			double k_re = spectrum[2 * bin];
+			double k_im = spectrum[2 * bin + 1];
+			double c_re = spectrum[2 * (half - bin)];
+			double c_im = -spectrum[2 * (half - bin) + 1];
+			double even_re = 0.5 * (k_re + c_re);
+			double even_im = 0.5 * (k_im + c_im);
+			double dif_re = 0.5 * (k_re - c_re);
+			double dif_im = 0.5 * (k_im - c_im);
+			double w_re = _real_twiddles[2 * bin];
+			double w_im = -_real_twiddles[2 * bin + 1];
+			double odd_re = dif_re * w_re - dif_im * w_im;
+			double odd_im = dif_re * w_im + dif_im * w_re;
+			long target = _bit_reverse[bin];
+			work[2 * target] = even_re - odd_im;
+			work[2 * target + 1] = even_im + odd_re;
+		}
+		return;
+	}
+	if (stage <= _passes)
+	{
+		Butterflies(stage - 1, begin, end, true);
+		return;
+	}
+	double scale = 1.0 / half;
+	for (long index = begin; index < end; index++)
+	{
+		signal[2 * index] = work[2 * index] * scale;
+		signal[2 * index + 1] = work[2 * index + 1] * scale;
+	}
+
+	return;
+}
+
+bool fft_real::Valid_Size(long size)
+{
+	if (size >= 4 && size <= LONG_MAX / 4 && (size & (size - 1)) == 0)
+	{
+		return true;
+	}
+	return false;
+}
+
+void fft_real::Butterflies(long pass, long begin, long end, bool inverse)
+{
+	// Req: passes in order, butterflies [begin, end) of Size() / 4
+	// Prom: in place radix-2 pass on bit reversed data, unscaled
+	long half = _size / 2;
+	long span = 1L << pass;
+	long stride = half / (2 * span);
+	double sign = inverse ? -1.0 : 1.0;
+	double* data = _work.data();
+	long butterfly = begin;
+	while (butterfly < end)
+	{
+		// Butterflies of one group share a run of twiddles
+		long first = butterfly & (span - 1);
+		long group = butterfly - first;
+		long last = std::min(end - group, span);
+		double* a = data + 4 * group;
+		double* b = a + 2 * span;
+		for (long pair = first; pair < last; pair++)
+		{
+			double w_re = _twiddles[2 * pair * stride];
+			double w_im = sign * _twiddles[2 * pair * stride + 1];
+			double t_re = b[2 * pair] * w_re - b[2 * pair + 1] * w_im;
+			double t_im = b[2 * pair] * w_im + b[2 * pair + 1] * w_re;
+			b[2 * pair] = a[2 * pair] - t_re;
+			b[2 * pair + 1] = a[2 * pair + 1] - t_im;
+			a[2 * pair] += t_re;
+			a[2 * pair + 1] += t_im;
+		}
+		butterfly = group + last;
+	}
+
+	return;
+}
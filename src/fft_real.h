@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>	// std::min
+#include <climits>
+#include <cmath>		// std::cos, std::sin
+#include <vector>
+
+#include "errors_custom.h"
+#include "pi_fir.h"
+
+class fft_real
+{
+private:
+	long _size;
+	long _passes;
+	std::vector<long> _bit_reverse;
+	std::vector<double> _twiddles;
+	std::vector<double> _real_twiddles;
+	std::vector<double> _work;
+
+public:
+	fft_real();
+	fft_real(long size);
+
+public:
+	void Configure(long size);
+	long Size() const;
+	long Spectrum_Size() const;
+	void Forward(double const* signal, double* spectrum);
+	void Inverse(double const* spectrum, double* signal);
+	long Stages() const;
+	long Stage_Size(long stage) const;
+	void Forward_Stage(double const* signal, double* spectrum, long stage,
+		long begin, long end);
+	void Inverse_Stage(double const* spectrum, double* signal, long stage,
+		long begin, long end);
+	static bool Valid_Size(long size);
+
+private:
+	void Butterflies(long pass, long begin, long end, bool inverse);
+};
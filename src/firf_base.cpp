@@ -2,7 +2,79 @@
 
 firf_base::firf_base() :
 	_samplerate(0.0), _error_max(0.0), _win_pow(0.0), _freq_min(0.0),
-	_delay_frac(0.0), _causal_taps_max(0), _total_taps_max(0) {}
+	_delay_frac(0.0), _causal_taps_max(0), _total_taps_max(0),
+	_stream_active(false), _imp_resp_valid(false),
+	_fft_threshold(Fft_Threshold_Default),
+	_partition_size(0), _hybrid_size(0), _threads(1),
+	_wvt_lookup(wvt_lookup::nearest) {}
+
+void firf_base::Process_Block(std::vector<double> const& block,
+	std::vector<double>& filtered_block)
+{
+	// Prom: ring buffer and impulse response persist between calls
+	// Prom: Process_Block(...) calls followed by Flush() are identical to
+	// a single Filter(...) call on the concatenated blocks below
+	// Get_Fft_Threshold() taps, within _error_max from it on
+	if (!_stream_active) { Start_Stream(); }
+	filtered_block.resize(block.size());
+	Process_Stream(block.data(), static_cast<long>(block.size()),
+		filtered_block.data());
+
+	return;
+}
+
+void firf_base::Process_Block(double const* block, long block_size,
+	double* filtered_block)
+{
+	// Req: block and filtered_block hold block_size samples
+	if (block_size < 0 || (block_size > 0
+		&& (block == nullptr || filtered_block == nullptr)))
+	{
+		throw parameter_error("Invalid block");
+	}
+	if (!_stream_active) { Start_Stream(); }
+	Process_Stream(block, block_size, filtered_block);
+
+	return;
+}
+
+std::vector<double> firf_base::Flush()
+{
+	// Prom: returns the _total_taps_max - 1 trailing samples of the stream,
+	// plus Get_Stream_Latency_Samples() samples still held by the stream
+	// Prom: next Process_Block(...) starts a new stream
+	if (!_stream_active) { return std::vector<double>(); }
+	std::vector<double> filtered_tail(
+		_total_taps_max - 1 + _partition_size, 0.0);
+	Flush_Stream(filtered_tail.data());
+
+	return filtered_tail;
+}
+
+void firf_base::Flush(double* filtered_tail, long tail_size)
+{
+	// Req: tail_size == Get_Filtered_Signal_Size(0)
+	// + Get_Stream_Latency_Samples()
+	if (!_stream_active)
+	{
+		throw config_error("No active stream to flush");
+	}
+	if (tail_size != _total_taps_max - 1 + _partition_size
+		|| filtered_tail == nullptr)
+	{
+		throw parameter_error("Invalid flushed signal size");
+	}
+	Flush_Stream(filtered_tail);
+
+	return;
+}
+
+void firf_base::Reset_Stream()
+{
+	_stream_active = false;
+
+	return;
+}
 
 long firf_base::Get_Group_Delay_Samples() const
 {
@@ -15,6 +87,276 @@ long firf_base::Get_Group_Delay_Samples() const
 	return group_delay_samples;
 }
 
+void firf_base::Set_Isa(mac_isa isa)
+{
+	// Prom: mac_isa::scalar selects the in-order reference summation
+	_ring_buffer.Set_Isa(isa);
+	_conv_hybrid.Set_Isa(isa);
+
+	return;
+}
+
+mac_isa firf_base::Get_Isa() const
+{
+	return _ring_buffer.Get_Isa();
+}
+
+void firf_base::Set_Fft_Threshold(long taps)
+{
+	// Prom: Filter(...) uses the fft engine from taps taps up, LONG_MAX
+	// keeps the direct form, streaming always uses the direct form
+	if (taps < 1)
+	{
+		throw parameter_error("Invalid fft threshold, range [1, LONG_MAX]");
+	}
+	_fft_threshold = taps;
+
+	return;
+}
+
+long firf_base::Get_Fft_Threshold() const
+{
+	return _fft_threshold;
+}
+
+void firf_base::Set_Partition_Size(long partition_size)
+{
+	// Prom: 0 streams through the ring buffer, a power of two streams
+	// through the partitioned convolver with partition_size samples of
+	// latency, config_error during an active stream
+	if (_stream_active)
+	{
+		throw config_error("Partition size set during an active stream");
+	}
+	if (partition_size != 0
+		&& !conv_partitioned::Valid_Partition_Size(partition_size))
+	{
+		throw parameter_error(
+			"Invalid partition size, 0 or power of two [2, 2^30]");
+	}
+	_partition_size = partition_size;
+	if (partition_size != 0) { _hybrid_size = 0; }
+
+	return;
+}
+
+long firf_base::Get_Partition_Size() const
+{
+	return _partition_size;
+}
+
+void firf_base::Set_Hybrid_Partition_Size(long partition_size)
+{
+	// Prom: 0 streams through the ring buffer, a power of two streams
+	// through the direct head and growing fft partitions of conv_hybrid
+	// without latency, config_error during an active stream
+	if (_stream_active)
+	{
+		throw config_error("Partition size set during an active stream");
+	}
+	if (partition_size != 0
+		&& !conv_partitioned::Valid_Partition_Size(partition_size))
+	{
+		throw parameter_error(
+			"Invalid partition size, 0 or power of two [2, 2^30]");
+	}
+	_hybrid_size = partition_size;
+	if (partition_size != 0) { _partition_size = 0; }
+
+	return;
+}
+
+long firf_base::Get_Hybrid_Partition_Size() const
+{
+	return _hybrid_size;
+}
+
+void firf_base::Set_Threads(long threads)
+{
+	// Prom: Filter(...) of constant filters splits the signal into up to
+	// threads segments, with a result identical to threads == 1
+	if (threads < 1)
+	{
+		throw parameter_error("Invalid thread count, range [1, LONG_MAX]");
+	}
+	_threads = threads;
+
+	return;
+}
+
+long firf_base::Get_Threads() const
+{
+	return _threads;
+}
+
+void firf_base::Set_Executor(task_executor executor)
+{
+	// Req: executor runs every task, in any order and on any thread, and
+	// returns once all of them have finished
+	// Prom: an empty executor runs the tasks on std::thread
+	_executor = std::move(executor);
+
+	return;
+}
+
+long firf_base::Get_Stream_Latency_Samples() const
+{
+	// Prom: samples Process_Block(...) output lags its input, in addition
+	// to Get_Group_Delay_Samples()
+	return _partition_size;
+}
+
+void firf_base::Set_Wvt_Lookup(wvt_lookup lookup)
+{
+	// Prom: wvt_lookup::linear interpolates the wavetables, which then hold
+	// about 1 / sqrt(error) instead of 1 / error elements
+	// Prom: wvt_lookup::direct evaluates every coefficient without tables,
+	// configure time and memory in proportion to the taps
+	// Prom: kept by Configure(...), set it on a default constructed filter
+	// to only ever build the tables of one lookup
+	// Prom: responses from the previous tables are discarded, an active
+	// stream keeps its response until it ends, strong exception safety
+	if (lookup == _wvt_lookup) { return; }
+	wvt_lookup lookup_prev = _wvt_lookup;
+	_wvt_lookup = lookup;
+	if (!Valid_Firf_Base()) { return; }
+	try { Set_Imp_Resp(); }
+	catch (...)
+	{
+		_wvt_lookup = lookup_prev;
+		throw;
+	}
+	Discard_Imp_Resp();
+
+	return;
+}
+
+wvt_lookup firf_base::Get_Wvt_Lookup() const
+{
+	return _wvt_lookup;
+}
+
+long firf_base::Get_Filtered_Signal_Size(long signal_size) const
+{
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (signal_size < 0
+		|| signal_size > LONG_MAX - (_total_taps_max - 1)
+		|| signal_size + _total_taps_max - 1 > pow(FLT_RADIX, DBL_MANT_DIG))
+	{
+		throw parameter_error(
+			"Invalid filtered signal size, reduce size of input signal");
+	}
+
+	return signal_size + _total_taps_max - 1;
+}
+
+void firf_base::Discard_Imp_Resp()
+{
+	// Prom: the response is synthesized again before the next use
+	_imp_resp_valid = false;
+
+	return;
+}
+
+void firf_base::Load_Imp_Resp()
+{
+	// Filters with temporal parameters need the full signal size to map
+	// their parameters, so they can only be used through Filter(...)
+	throw config_error("Streaming requires constant filter parameters");
+}
+
+void firf_base::Update_Imp_Resp()
+{
+	// Req: called after the filter parameters changed
+	// Prom: the normalized impulse response is synthesized now, or when
+	// the active stream ends, and reused by every following Filter(...)
+	_imp_resp_valid = false;
+	if (_stream_active) { return; }
+	Load_Imp_Resp();
+	_imp_resp_valid = true;
+
+	return;
+}
+
+std::vector<double> firf_base::Filter_Stream(std::vector<double> const& signal)
+{
+	// Prom: config_error during an active stream
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	std::vector<double> filt_sig;
+	auto filt_sig_size = Filtered_Signal_Size(signal.size(), filt_sig);
+	filt_sig = std::vector<double>(filt_sig_size, 0.0);
+	Filter_Stream(signal.data(), static_cast<long>(signal.size()),
+		filt_sig.data(), static_cast<long>(filt_sig.size()));
+
+	return filt_sig;
+}
+
+void firf_base::Filter_Stream(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	// Prom: config_error during an active stream, which shares the ring
+	// buffer and the response, Flush() or Reset_Stream() ends it
+	// Prom: no allocation once the impulse response has been synthesized
+	// and the ring buffer or fft engine sized for the current configuration
+	// Prom: responses of _fft_threshold taps or more use the fft engine,
+	// which agrees with the direct form within _error_max
+	if (filtered_signal_size != Get_Filtered_Signal_Size(signal_size)
+		|| (signal_size > 0 && signal == nullptr)
+		|| filtered_signal == nullptr)
+	{
+		throw parameter_error("Invalid signal or filtered signal size");
+	}
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (_stream_active)
+	{
+		throw config_error("Filter(...) during an active stream");
+	}
+	Prepare_Imp_Resp();
+	if (static_cast<long>(_imp_resp_ring.size()) >= _fft_threshold)
+	{
+		Filter_Fft(signal, signal_size, filtered_signal,
+			filtered_signal_size);
+		return;
+	}
+	long segments = std::min(_threads, filtered_signal_size
+		/ std::max(Segment_Samples_Min, 8 * _total_taps_max));
+	if (segments > 1)
+	{
+		Filter_Segments(signal, signal_size, filtered_signal,
+			filtered_signal_size, segments);
+		return;
+	}
+	Reset_Ring_Buffer();
+	Process_Direct(signal, signal_size, filtered_signal);
+	Flush_Direct(filtered_signal + signal_size);
+
+	return;
+}
+
+void firf_base::Reset_Ring_Buffer()
+{
+	// Prom: ring buffer only allocates when the configuration changes
+	if (_ring_buffer.Size() != _total_taps_max)
+	{
+		_ring_buffer.Configure(_total_taps_max, _causal_taps_max);
+	}
+	else
+	{
+		_ring_buffer.Clear();
+	}
+
+	return;
+}
+
 void firf_base::Set_Base_Configs(double samplerate, double error_max,
 	double freq_min, double win_pow, double delay_frac)
 {
@@ -36,35 +378,82 @@ void firf_base::Test_Ring_Buffer(long total_samples, long causal_samples)
 	return;
 }
 
-void firf_base::Normalize_Abs_Kahan(std::vector<double>& vtr_to_norm)
+void firf_base::Normalize_Abs_Neumaier(std::vector<double>& vtr_to_norm)
 {
 	// Req: vtr_to_norm must be non-trivial
-	// Prom: Uses Kahan summation for normalization factor
-	std::vector<double> abs_sorted(vtr_to_norm);
-	for (auto& element : abs_sorted) { element = std::abs(element); }
-	std::sort(abs_sorted.begin(), abs_sorted.end());
-	
-	// Kahan Sum and normalize
-	double sum = 0.0;
-	double c = 0.0;
-	for (auto& element : abs_sorted)
+	// Prom: Uses Neumaier summation for normalization factor
+	// Prom: no allocation, one pass to sum and one to divide
+	double total = Sum_Abs_Neumaier(vtr_to_norm);
+	for (auto& element : vtr_to_norm) { element /= total; };
+
+	return;
+}
+
+double firf_base::Sum_Abs_Neumaier(
+	std::vector<double> const& vtr_to_sum) const
+{
+	// Prom: sum of the absolute values, no allocation
+	//
+	// The absolute values are summed in four interleaved Neumaier
+	// accumulators, whose sums and compensations are combined by a final
+	// Neumaier pass. Neumaier summation does not need sorted input: with
+	// non negative terms the relative error of the sum stays within
+	// 2e + O(ne^2), the bound Kahan summation of the sorted values gave.
+	constexpr long lanes = 4;
+	double sum[lanes] = { 0.0, 0.0, 0.0, 0.0 };
+	double c[lanes] = { 0.0, 0.0, 0.0, 0.0 };
+	long size = static_cast<long>(vtr_to_sum.size());
+	long index = 0;
+	for (; index + lanes <= size; index += lanes)
+	{
+		for (long lane = 0; lane < lanes; lane++)
+		{
+			double element = std::abs(vtr_to_sum[index + lane]);
+			double t = sum[lane] + element;
+			double big = std::max(sum[lane], element);
+			double small = std::min(sum[lane], element);
+			c[lane] += (big - t) + small;
+			sum[lane] = t;
+		}
+	}
+	for (; index < size; index++)
+	{
+		double element = std::abs(vtr_to_sum[index]);
+		double t = sum[0] + element;
+		double big = std::max(sum[0], element);
+		double small = std::min(sum[0], element);
+		c[0] += (big - t) + small;
+		sum[0] = t;
+	}
+	double total = 0.0;
+	double total_c = 0.0;
+	for (long lane = 0; lane < 2 * lanes; lane++)
 	{
-		double y = element - c;
-		double t = sum + y;
-		c = (t - sum) - y;
-		sum = t;
+		double element = (lane < lanes) ? sum[lane] : c[lane - lanes];
+		double t = total + element;
+		if (std::abs(total) >= std::abs(element))
+		{
+			total_c += (total - t) + element;
+		}
+		else
+		{
+			total_c += (element - t) + total;
+		}
+		total = t;
 	}
-	for (auto& element : vtr_to_norm) { element /= sum; };
+	total += total_c;
 
-	return;
+	return total;
 }
 
 double firf_base::Error_Imp_Resp(double total_taps_max, double error_max)
 {
 	// Prom: the correct error to construct imp_resp
-	// Prom: accounts for Kahan normalization, tap * data, and summation
+	// Prom: accounts for Neumaier normalization, tap * data, and summation
 	// ((error_from_imp_resp + 2e)n^2 + 7en + 2e < _error_max
 	// n = buffer_size, e = machine_epsilon, error = for imp_resp
+	// The vector kernels of mac_kernel reorder the tap * data summation
+	// but do not exceed its ne term, see mac_kernel.cpp
 	double a = (4.0 * DBL_EPSILON * total_taps_max) + (2.0 * DBL_EPSILON);
 	double error_imp_resp = error_max - a;
 
@@ -96,6 +485,35 @@ std::vector<double> firf_base::Get_Full_Imp_Resp(
 	return full_imp_resp;
 }
 
+void firf_base::Get_Ring_Imp_Resp(std::vector<double> const& causal_resp,
+	std::vector<double>& ring_imp_resp)
+{
+	// causal_resp.size() [0, _causal_taps_max]
+	// Prom: full response in ring_buffer order, the reverse of
+	// Get_Full_Imp_Resp(...), with the tap of the oldest sample first
+	// Prom: no allocation once ring_imp_resp holds _total_taps_max
+	long causal_taps = static_cast<long>(causal_resp.size());
+	long non_causal_taps = static_cast<long>((causal_taps - 1) * _delay_frac);
+	long total_taps = causal_taps + non_causal_taps;
+	ring_imp_resp.reserve(_total_taps_max);
+	ring_imp_resp.resize(total_taps);
+	long index = 0;
+	while (index < causal_taps)
+	{
+		long tap = causal_taps - 1 - index;
+		ring_imp_resp[index] = causal_resp[tap];
+		index++;
+	}
+	while (index < total_taps)
+	{
+		long tap = index - causal_taps + 1;
+		ring_imp_resp[index] = causal_resp[tap];
+		index++;
+	}
+
+	return;
+}
+
 std::vector<double>::size_type firf_base::Filtered_Signal_Size(
 	std::vector<double>::size_type signal_size,
 	std::vector<double> const& filtered_signal_container)
@@ -114,6 +532,282 @@ std::vector<double>::size_type firf_base::Filtered_Signal_Size(
 	return f_sig_size;
 }
 
+void firf_base::Prepare_Imp_Resp()
+{
+	// Prom: synthesizes the impulse response only if the parameters
+	// changed since it was last synthesized
+	if (_imp_resp_valid) { return; }
+	Load_Imp_Resp();
+	_imp_resp_valid = true;
+
+	return;
+}
+
+void firf_base::Start_Stream()
+{
+	// Prom: impulse response is only synthesized when parameters changed
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	Prepare_Imp_Resp();
+	if (_partition_size > 0)
+	{
+		_conv_partitioned.Configure(_imp_resp_ring, Causal_Dif(),
+			_partition_size);
+	}
+	else if (_hybrid_size > 0)
+	{
+		_conv_hybrid.Configure(_imp_resp_ring, Causal_Dif(), _hybrid_size);
+	}
+	else
+	{
+		Reset_Ring_Buffer();
+	}
+	_stream_active = true;
+
+	return;
+}
+
+void firf_base::Process_Stream(double const* block, long block_size,
+	double* filtered_block)
+{
+	// Req: Start_Stream()
+	if (_partition_size > 0)
+	{
+		_conv_partitioned.Process(block, block_size, filtered_block);
+		return;
+	}
+	if (_hybrid_size > 0)
+	{
+		_conv_hybrid.Process(block, block_size, filtered_block);
+		return;
+	}
+	Process_Direct(block, block_size, filtered_block);
+
+	return;
+}
+
+void firf_base::Flush_Stream(double* filtered_tail)
+{
+	// Req: Start_Stream() && filtered_tail holds _total_taps_max - 1
+	// + _partition_size samples
+	if (_partition_size > 0)
+	{
+		_conv_partitioned.Process_Zeros(_total_taps_max - 1 + _partition_size,
+			filtered_tail);
+	}
+	else if (_hybrid_size > 0)
+	{
+		_conv_hybrid.Process_Zeros(_total_taps_max - 1, filtered_tail);
+	}
+	else
+	{
+		Flush_Direct(filtered_tail);
+	}
+	_stream_active = false;
+
+	return;
+}
+
+void firf_base::Process_Direct(double const* block, long block_size,
+	double* filtered_block)
+{
+	// Req: Load_Imp_Resp() && Reset_Ring_Buffer()
+	// Prom: samples are copied into the ring buffer a block at a time
+	long sample = 0;
+	while (sample < block_size)
+	{
+		long insert_size = std::min(block_size - sample,
+			_ring_buffer.Block_Size());
+		_ring_buffer.Insert_Block(block + sample, insert_size);
+		_ring_buffer.Process_Cycles(_imp_resp_ring, _imp_resp_causal,
+			insert_size, filtered_block + sample);
+		sample += insert_size;
+	}
+
+	return;
+}
+
+void firf_base::Flush_Direct(double* filtered_tail)
+{
+	// Req: Process_Direct(...) && filtered_tail holds _total_taps_max - 1
+	long tail_size = _total_taps_max - 1;
+	long sample = 0;
+	while (sample < tail_size)
+	{
+		long insert_size = std::min(tail_size - sample,
+			_ring_buffer.Block_Size());
+		_ring_buffer.Insert_Zeros(insert_size);
+		_ring_buffer.Process_Cycles(_imp_resp_ring, _imp_resp_causal,
+			insert_size, filtered_tail + sample);
+		sample += insert_size;
+	}
+
+	return;
+}
+
+void firf_base::Filter_Fft(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	// Req: Load_Imp_Resp()
+	// Prom: with _threads > 1 the blocks are split between threads, each
+	// block is computed as in the single threaded case
+	long causal_dif = Causal_Dif();
+	_conv_ols.Configure(_imp_resp_ring, filtered_signal_size);
+	long blocks = _conv_ols.Blocks(signal_size, causal_dif,
+		filtered_signal_size);
+	long segments = std::min(_threads, blocks);
+	if (segments <= 1)
+	{
+		_conv_ols.Convolve(signal, signal_size, causal_dif, filtered_signal,
+			filtered_signal_size);
+		return;
+	}
+	_conv_ols.Zero_Fill(signal_size, causal_dif, filtered_signal,
+		filtered_signal_size);
+	// Configure(...) returns at once for unchanged taps and fft size, the
+	// segment engines only transform the taps when the response changes
+	_segment_ols.resize(segments - 1);
+	for (auto& engine : _segment_ols)
+	{
+		engine.Configure(_imp_resp_ring, filtered_signal_size);
+	}
+	std::vector<std::function<void()>> tasks;
+	for (long segment = 0; segment < segments; segment++)
+	{
+		conv_ols* engine = (segment == 0)
+			? &_conv_ols : &_segment_ols[segment - 1];
+		long first = blocks * segment / segments;
+		long last = blocks * (segment + 1) / segments;
+		tasks.push_back([=]()
+		{
+			engine->Convolve_Blocks(signal, signal_size, causal_dif,
+				filtered_signal, filtered_signal_size, first, last);
+		});
+	}
+	Run_Tasks(tasks);
+
+	return;
+}
+
+void firf_base::Filter_Segments(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size, long segments)
+{
+	// Req: Load_Imp_Resp(), segments > 1
+	// Prom: each segment is filtered in its own ring buffer, warmed with
+	// the _total_taps_max - 1 preceding samples, the tiled kernel makes
+	// every output independent of the segment boundaries
+	_segment_buffers.resize(segments);
+	for (auto& buffer : _segment_buffers)
+	{
+		if (buffer.Size() != _total_taps_max)
+		{
+			buffer.Configure(_total_taps_max, _causal_taps_max);
+		}
+		buffer.Set_Isa(_ring_buffer.Get_Isa());
+		buffer.Clear();
+	}
+	std::vector<std::function<void()>> tasks;
+	for (long segment = 0; segment < segments; segment++)
+	{
+		ring_buffer* buffer = &_segment_buffers[segment];
+		long first = filtered_signal_size * segment / segments;
+		long last = filtered_signal_size * (segment + 1) / segments;
+		tasks.push_back([=]()
+		{
+			Filter_Segment(*buffer, signal, signal_size, filtered_signal,
+				first, last);
+		});
+	}
+	Run_Tasks(tasks);
+
+	return;
+}
+
+void firf_base::Filter_Segment(ring_buffer& buffer, double const* signal,
+	long signal_size, double* filtered_signal, long first, long last)
+{
+	// Req: buffer cleared, configured like _ring_buffer
+	// Prom: filtered_signal [first, last), the input past signal_size is
+	// zero like in Flush_Direct(...)
+	long sample = std::max(0L, first - (_total_taps_max - 1));
+	while (sample < last)
+	{
+		long insert_end = std::min(last, sample + buffer.Block_Size());
+		if (sample < first) { insert_end = std::min(insert_end, first); }
+		long signal_end = std::min(insert_end, signal_size);
+		if (sample < signal_end)
+		{
+			buffer.Insert_Block(signal + sample, signal_end - sample);
+		}
+		buffer.Insert_Zeros(insert_end - std::max(sample, signal_end));
+		if (sample >= first)
+		{
+			buffer.Process_Cycles(_imp_resp_ring, _imp_resp_causal,
+				insert_end - sample, filtered_signal + sample);
+		}
+		sample = insert_end;
+	}
+
+	return;
+}
+
+void firf_base::Run_Tasks(std::vector<std::function<void()>> const& tasks)
+{
+	// Prom: returns once every task has finished, rethrows the first
+	// exception of a task
+	// Prom: when a thread cannot be started, the started tasks finish and
+	// the std::system_error is rethrown
+	if (_executor)
+	{
+		_executor(tasks);
+		return;
+	}
+	std::vector<std::exception_ptr> errors(tasks.size());
+	std::vector<std::thread> threads;
+	try
+	{
+		for (std::size_t task = 1; task < tasks.size(); task++)
+		{
+			threads.emplace_back([&tasks, &errors, task]()
+			{
+				try { tasks[task](); }
+				catch (...) { errors[task] = std::current_exception(); }
+			});
+		}
+	}
+	catch (...)
+	{
+		// A thread failed to start, the started ones must be joined
+		// before they are destroyed
+		for (auto& thread : threads) { thread.join(); }
+		throw;
+	}
+	try { tasks[0](); }
+	catch (...) { errors[0] = std::current_exception(); }
+	for (auto& thread : threads) { thread.join(); }
+	for (auto& error : errors)
+	{
+		if (error) { std::rethrow_exception(error); }
+	}
+
+	return;
+}
+
+long firf_base::Causal_Dif() const
+{
+	// Req: Load_Imp_Resp()
+	// Prom: delay of responses shorter than _total_taps_max, as applied by
+	// ring_buffer::Process_Cycle(...)
+	long total_taps = static_cast<long>(_imp_resp_ring.size());
+	long causal_taps = static_cast<long>(_imp_resp_causal.size());
+	long causal_dif = (_total_taps_max - _causal_taps_max)
+		- (total_taps - causal_taps);
+
+	return causal_dif;
+}
+
 void firf_base::Set_Error_Max(double error_max)
 {
 	if (!Valid_Error_Max(error_max))
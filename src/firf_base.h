@@ -1,15 +1,28 @@
 #pragma once
 
-#include <algorithm>	// std::sort
+#include <algorithm>	// std::min, std::max
 #include <cmath>		// std::pow, std::ceil, std::fmod
 #include <cfloat>
 #include <climits>
+#include <exception>	// std::exception_ptr
+#include <functional>	// std::function
+#include <thread>
 #include <vector>
 
+#include "conv_hybrid.h"
+#include "conv_ols.h"
+#include "conv_partitioned.h"
 #include "ring_buffer.h"
+#include "wvt_base.h"
 
 class firf_base
 {
+public:
+	static constexpr long Fft_Threshold_Default = 128;
+	static constexpr long Segment_Samples_Min = 16384;
+	using task_executor =
+		std::function<void(std::vector<std::function<void()>> const&)>;
+
 protected:
 	double _samplerate;
 	double _error_max;
@@ -18,27 +31,94 @@ protected:
 	double _delay_frac;
 	long _causal_taps_max;
 	long _total_taps_max;
+	ring_buffer _ring_buffer;
+	std::vector<double> _imp_resp_ring;
+	std::vector<double> _imp_resp_causal;
+	bool _stream_active;
+	bool _imp_resp_valid;
+	long _fft_threshold;
+	long _partition_size;
+	long _hybrid_size;
+	conv_ols _conv_ols;
+	conv_partitioned _conv_partitioned;
+	conv_hybrid _conv_hybrid;
+	long _threads;
+	task_executor _executor;
+	wvt_lookup _wvt_lookup;
+	std::vector<ring_buffer> _segment_buffers;
+	std::vector<conv_ols> _segment_ols;
 
 protected:
 	firf_base();
 
 public:
 	virtual std::vector<double> Filter(std::vector<double> const& signal) = 0;
+	virtual void Filter(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size) = 0;
+	void Process_Block(std::vector<double> const& block,
+		std::vector<double>& filtered_block);
+	void Process_Block(double const* block, long block_size,
+		double* filtered_block);
+	std::vector<double> Flush();
+	void Flush(double* filtered_tail, long tail_size);
+	void Reset_Stream();
 	long Get_Group_Delay_Samples() const;
+	long Get_Filtered_Signal_Size(long signal_size) const;
+	void Set_Isa(mac_isa isa);
+	mac_isa Get_Isa() const;
+	void Set_Fft_Threshold(long taps);
+	long Get_Fft_Threshold() const;
+	void Set_Partition_Size(long partition_size);
+	long Get_Partition_Size() const;
+	void Set_Hybrid_Partition_Size(long partition_size);
+	long Get_Hybrid_Partition_Size() const;
+	void Set_Threads(long threads);
+	long Get_Threads() const;
+	void Set_Executor(task_executor executor);
+	long Get_Stream_Latency_Samples() const;
+	void Set_Wvt_Lookup(wvt_lookup lookup);
+	wvt_lookup Get_Wvt_Lookup() const;
 
 protected:
+	virtual void Set_Imp_Resp() = 0;
+	virtual void Discard_Imp_Resp();
+	virtual void Load_Imp_Resp();
+	void Update_Imp_Resp();
+	std::vector<double> Filter_Stream(std::vector<double> const& signal);
+	void Filter_Stream(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size);
+	void Reset_Ring_Buffer();
 	void Set_Base_Configs(double samplerate, double error_max,
 		double freq_min, double win_pow, double delay_frac);
 	void Test_Ring_Buffer(long total_samples, long causal_samples);
-	void Normalize_Abs_Kahan(std::vector<double>& vtr_to_norm);
+	void Normalize_Abs_Neumaier(std::vector<double>& vtr_to_norm);
+	double Sum_Abs_Neumaier(std::vector<double> const& vtr_to_sum) const;
 	double Error_Imp_Resp(double total_taps_max, double error_max);
 	std::vector<double> Get_Full_Imp_Resp(
 		std::vector<double> const& causal_resp, double delay_frac);
+	void Get_Ring_Imp_Resp(std::vector<double> const& causal_resp,
+		std::vector<double>& ring_imp_resp);
 	std::vector<double>::size_type Filtered_Signal_Size(
 		std::vector<double>::size_type signal_size,
 		std::vector<double> const& filtered_signal_container);
 
 private:
+	void Prepare_Imp_Resp();
+	void Start_Stream();
+	void Process_Stream(double const* block, long block_size,
+		double* filtered_block);
+	void Flush_Stream(double* filtered_tail);
+	void Process_Direct(double const* block, long block_size,
+		double* filtered_block);
+	void Flush_Direct(double* filtered_tail);
+	long Causal_Dif() const;
+	void Filter_Fft(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size);
+	void Filter_Segments(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size, long segments);
+	void Filter_Segment(ring_buffer& buffer, double const* signal,
+		long signal_size, double* filtered_signal, long first, long last);
+	void Run_Tasks(std::vector<std::function<void()>> const& tasks);
 	void Set_Samplerate(double samplerate);
 	void Set_Error_Max(double error_max);
 	void Set_Win_Pow(double win_pow);
@@ -25,9 +25,14 @@ public:
 		double win_pow, double delay_frac, double freq_center, double freq_bw,
 		double atten);
 	std::vector<double> Filter(std::vector<double> const& signal) override;
+	void Filter(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size) override;
+
+protected:
+	void Load_Imp_Resp() override;
 
 private:
-	void Set_Imp_Resp();
+	void Set_Imp_Resp() override;
 	bool Valid_Freq_Bw_Parameter(double freq_center,
 		double samplerate) const;
 	bool Valid_Fshift_Parameter(double freq_shift, double samplerate) const;
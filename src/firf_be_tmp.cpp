@@ -1,8 +1,7 @@
 #include "firf_be_tmp.h"
 
 firf_be_tmp::firf_be_tmp() :
-	firf_base(), _freq_center(nullptr), _freq_bw(nullptr),
-	_atten(nullptr) {}
+	firf_tmp_base(), _heterodyne(false) {}
 
 firf_be_tmp::firf_be_tmp(double samplerate, double error_max,
 	double freq_bw_min, double win_pow, double delay_frac) :
@@ -30,6 +29,30 @@ void firf_be_tmp::Set_Parameters(std::vector<double> const* freq_center,
 	{
 		throw parameter_error("Invalid filter parameters");
 	}
+	_freq_center = param_env(freq_center);
+	_freq_bw = param_env(freq_bw);
+	_atten = param_env(atten);
+
+	return;
+}
+
+void firf_be_tmp::Set_Parameters(param_env const& freq_center,
+	param_env const& freq_bw, param_env const& atten)
+{
+	// Prom: generator values are checked when their response is loaded
+	if (!Valid_Samplerate(_samplerate))
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	auto valid_freq = [this](double freq)
+		{ return _imp_resp.Valid_Freq_Input(freq); };
+	if (!freq_center.Valid_Values(valid_freq)
+		|| !freq_bw.Valid_Values(valid_freq)
+		|| !atten.Valid_Values([this](double atten_frac)
+		{ return _imp_resp.Valid_atten_Frac(atten_frac); }))
+	{
+		throw parameter_error("Invalid filter parameters");
+	}
 	_freq_center = freq_center;
 	_freq_bw = freq_bw;
 	_atten = atten;
@@ -44,6 +67,7 @@ void firf_be_tmp::Configure(double samplerate, double error_max,
 	std::vector<double> const* atten)
 {
 	auto temp_firf = std::make_unique<firf_be_tmp>();
+	temp_firf->_wvt_lookup = _wvt_lookup;
 	temp_firf->Set_Base_Configs(samplerate, error_max,
 		freq_bw_min / 2.0, win_pow, delay_frac);
 	temp_firf->Set_Imp_Resp();
@@ -55,75 +79,114 @@ void firf_be_tmp::Configure(double samplerate, double error_max,
 
 std::vector<double> firf_be_tmp::Filter(std::vector<double> const& signal)
 {
+	if (!_heterodyne) { return Filter_Temporal(signal); }
 	if (!Valid_Firf_Base())
 	{
 		throw config_error("Invalid filter configuration");
 	}
-	if (_freq_center == nullptr || _freq_bw == nullptr || _atten == nullptr)
-	{
-		throw parameter_error("Invalid filter parameter(s)");
-	}
 	std::vector<double> filt_sig;
 	auto filt_sig_size = Filtered_Signal_Size(signal.size(), filt_sig);
 	filt_sig = std::vector<double>(filt_sig_size, 0.0);
-	double freq_center = 0.0;
-	double freq_bw = 0.0;
-	double atten = 0.0;
-	std::tie(freq_center, freq_bw, atten) =
-		Get_Parameters(0, 0, signal.size());
-	std::vector<double> imp_resp_causal = _imp_resp.Get_Causal_Imp_Resp(
-		freq_center, freq_bw, atten);
-	std::vector<double> imp_resp = Get_Full_Imp_Resp(imp_resp_causal,
-		_delay_frac);
-	Normalize_Abs_Kahan(imp_resp);
-	ring_buffer buffer(_total_taps_max, _causal_taps_max);
-	long sample = 0;
-	long load_samples = (_total_taps_max - _causal_taps_max)
-		- (static_cast<long>(imp_resp.size())
-		- static_cast<long>(imp_resp_causal.size()));
-	while (sample < load_samples && sample < signal.size()
-		&& sample < filt_sig.size())
-	{
-		buffer.Insert(signal.at(sample));
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
-	}
-	while (sample < load_samples)
-	{
-		buffer.Insert(0.0);
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
-	}
-	while (sample < signal.size() && sample < filt_sig.size())
-	{
-		std::tie(freq_center, freq_bw, atten) =
-			Get_Parameters(sample, load_samples, signal.size());
-		imp_resp_causal = _imp_resp.Get_Causal_Imp_Resp(freq_center,
-			freq_bw, atten);
-		imp_resp = Get_Full_Imp_Resp(imp_resp_causal, _delay_frac);
-		Normalize_Abs_Kahan(imp_resp);
-		buffer.Insert(signal.at(sample));
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
-	}
-	while (sample < filt_sig.size())
-	{
-		buffer.Insert(0.0);
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
-	}
+	Filter(signal.data(), static_cast<long>(signal.size()), filt_sig.data(),
+		static_cast<long>(filt_sig.size()));
 
 	return filt_sig;
 }
 
+void firf_be_tmp::Filter(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	if (!_heterodyne || (Valid_Parameters() && !_freq_center.Constant()))
+	{
+		Filter_Temporal(signal, signal_size, filtered_signal,
+			filtered_signal_size);
+		return;
+	}
+	if (Valid_Parameters()
+		&& (!_freq_bw.Constant() || !_atten.Constant()))
+	{
+		throw parameter_error("Heterodyne mode needs constant bandwidth "
+			"and attenuation");
+	}
+	Filter_Heterodyne(signal, signal_size, filtered_signal,
+		filtered_signal_size, _imp_resp.Get_Cos_Wvt());
+
+	return;
+}
+
+void firf_be_tmp::Set_Heterodyne(bool heterodyne)
+{
+	// Prom: Filter(...) mixes the signal down to the band prototype and
+	// back up instead of synthesizing a response per centre frequency
+	// Prom: within error_max of the per sample responses, a moving centre
+	// frequency filters with the per sample responses
+	_heterodyne = heterodyne;
+
+	return;
+}
+
+bool firf_be_tmp::Get_Heterodyne() const
+{
+	return _heterodyne;
+}
+
+bool firf_be_tmp::Valid_Parameters() const
+{
+	if (_freq_center.Valid_Param_Env() && _freq_bw.Valid_Param_Env()
+		&& _atten.Valid_Param_Env())
+	{
+		return true;
+	}
+	return false;
+}
+
+firf_tmp_base::kernel_key firf_be_tmp::Temporal_Kernel_Key(long curr_sample,
+	long load_samples, long signal_size) const
+{
+	return Get_Parameters(curr_sample, load_samples, signal_size);
+}
+
+bool firf_be_tmp::Valid_Kernel_Key(kernel_key const& key) const
+{
+	// Prom: key is (freq_center, freq_bw, atten)
+	if (_imp_resp.Valid_Freq_Input(std::get<0>(key))
+		&& _imp_resp.Valid_Freq_Input(std::get<1>(key))
+		&& _imp_resp.Valid_atten_Frac(std::get<2>(key)))
+	{
+		return true;
+	}
+	return false;
+}
+
+void firf_be_tmp::Synthesize_Imp_Resp(kernel_key const& key)
+{
+	_imp_resp.Get_Causal_Imp_Resp(std::get<0>(key), std::get<1>(key),
+		std::get<2>(key), _imp_resp_causal);
+	Get_Ring_Imp_Resp(_imp_resp_causal, _imp_resp_ring);
+	Normalize_Abs_Neumaier(_imp_resp_ring);
+
+	return;
+}
+
+void firf_be_tmp::Load_Heterodyne_Imp_Resp(kernel_key const& key)
+{
+	// Prom: prototype at a centre frequency of 0 Hz, scaled by the
+	// normalization of the response at key
+	_imp_resp.Get_Causal_Imp_Resp(std::get<0>(key), std::get<1>(key),
+		std::get<2>(key), _imp_resp_causal);
+	Get_Ring_Imp_Resp(_imp_resp_causal, _imp_resp_ring);
+	double sum = Sum_Abs_Neumaier(_imp_resp_ring);
+	_imp_resp.Get_Causal_Imp_Resp(0.0, std::get<1>(key), std::get<2>(key),
+		_imp_resp_causal);
+	Get_Ring_Imp_Resp(_imp_resp_causal, _imp_resp_ring);
+	if (sum > 0.0)
+	{
+		for (auto& tap : _imp_resp_ring) { tap /= sum; }
+	}
+
+	return;
+}
+
 bool firf_be_tmp::Valid_Freq_Parameters(std::vector<double> const* freq_center,
 	std::vector<double> const* freq_bw, double samplerate) const
 {
@@ -184,7 +247,7 @@ void firf_be_tmp::Set_Imp_Resp()
 	// Req: Valid_Firf_Base()
 	double error_max_imp_resp = Error_Imp_Resp(_total_taps_max, _error_max);
 	_imp_resp.Configure(_samplerate, error_max_imp_resp, _win_pow,
-		_causal_taps_max);
+		_causal_taps_max, _wvt_lookup);
 
 	return;
 }
@@ -192,19 +255,12 @@ void firf_be_tmp::Set_Imp_Resp()
 std::tuple<double, double, double> firf_be_tmp::Get_Parameters(long curr_sample,
 	long load_samples, std::vector<double>::size_type signal_size) const
 {
-	// Req: Valid_Freq_Parameter(_freq_center, _freq_bw _samplerate)
+	// Req: Valid_Parameters()
 	// Req: Filtered_Signal_Size(signal_size, ...)
 	long rel_sample = curr_sample - load_samples;
-	double rel_sample_fp = static_cast<double>(rel_sample);
-	double signal_size_fp = static_cast<double>(signal_size);
-	double temporal_frac = rel_sample_fp / signal_size_fp;
-	double freq_c_size_fp = static_cast<double>(_freq_center->size());
-	double freq_bw_size_fp = static_cast<double>(_freq_bw->size());
-	double atten_size_fp = static_cast<double>(_atten->size());
-	long freq_c_index = static_cast<long>(temporal_frac * freq_c_size_fp);
-	long freq_bw_index = static_cast<long>(temporal_frac * freq_bw_size_fp);
-	long atten_index = static_cast<long>(temporal_frac * atten_size_fp);
-
-	return std::make_tuple(_freq_center->at(freq_c_index),
-		_freq_bw->at(freq_bw_index), _atten->at(atten_index));
+	long signal_samples = static_cast<long>(signal_size);
+
+	return std::make_tuple(_freq_center.Value(rel_sample, signal_samples),
+		_freq_bw.Value(rel_sample, signal_samples),
+		_atten.Value(rel_sample, signal_samples));
 }
\ No newline at end of file
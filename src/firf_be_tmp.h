@@ -9,16 +9,18 @@
 #include <vector>
 
 #include "errors_custom.h"
-#include "firf_base.h"
+#include "firf_tmp_base.h"
 #include "imp_resp_be.h"
+#include "param_env.h"
 
-class firf_be_tmp : public firf_base
+class firf_be_tmp : public firf_tmp_base
 {
 private:
-	std::vector<double> const* _freq_center;
-	std::vector<double> const* _freq_bw;
-	std::vector<double> const* _atten;
+	param_env _freq_center;
+	param_env _freq_bw;
+	param_env _atten;
 	imp_resp_be _imp_resp;
+	bool _heterodyne;
 
 public:
 	firf_be_tmp();
@@ -29,18 +31,32 @@ public:
 	void Set_Parameters(std::vector<double> const* freq_center,
 		std::vector<double> const* freq_bw,
 		std::vector<double> const* atten);
+	void Set_Parameters(param_env const& freq_center,
+		param_env const& freq_bw, param_env const& atten);
 	void Configure(double samplerate, double error_max, double freq_bw_min,
 		double win_pow, double delay_frac,
 		std::vector<double> const* freq_center,
 		std::vector<double> const* freq_bw,
 		std::vector<double> const* atten);
 	std::vector<double> Filter(std::vector<double> const& signal) override;
+	void Filter(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size) override;
+	void Set_Heterodyne(bool heterodyne);
+	bool Get_Heterodyne() const;
+
+protected:
+	bool Valid_Parameters() const override;
+	bool Valid_Kernel_Key(kernel_key const& key) const override;
+	kernel_key Temporal_Kernel_Key(long curr_sample, long load_samples,
+		long signal_size) const override;
+	void Synthesize_Imp_Resp(kernel_key const& key) override;
+	void Load_Heterodyne_Imp_Resp(kernel_key const& key) override;
 
 private:
 	bool Valid_Freq_Parameters(std::vector<double> const* freq_center,
 		std::vector<double> const* freq_bw, double samplerate) const;
 	bool Valid_atten_Parameter(std::vector<double> const* atten) const;
-	void Set_Imp_Resp();
+	void Set_Imp_Resp() override;
 	std::tuple<double, double, double> Get_Parameters(long curr_sample,
 		long load_samples, std::vector<double>::size_type signal_size) const;
 };
\ No newline at end of file
@@ -26,8 +26,17 @@ void firf_hp::Set_Parameters(double freq_cutoff, double atten)
 	{
 		throw parameter_error("Invalid filter parameter");
 	}
+	double freq_cutoff_prev = _freq_cutoff;
+	double atten_prev = _atten;
 	_freq_cutoff = freq_cutoff;
 	_atten = atten;
+	try { Update_Imp_Resp(); }
+	catch (...)
+	{
+		_freq_cutoff = freq_cutoff_prev;
+		_atten = atten_prev;
+		throw;
+	}
 
 	return;
 }
@@ -36,6 +45,7 @@ void firf_hp::Configure(double samplerate, double error_max, double freq_min,
 	double win_pow, double delay_frac, double freq_cutoff, double atten)
 {
 	auto temp_firf = std::make_unique<firf_hp>();
+	temp_firf->_wvt_lookup = _wvt_lookup;
 	temp_firf->Set_Base_Configs(samplerate, error_max, freq_min, win_pow,
 		delay_frac);
 	temp_firf->Set_Imp_Resp();
@@ -47,43 +57,29 @@ void firf_hp::Configure(double samplerate, double error_max, double freq_min,
 
 std::vector<double> firf_hp::Filter(std::vector<double> const& signal)
 {
-	if (!Valid_Firf_Base())
-	{
-		throw config_error("Invalid filter configuration");
-	}
+	return Filter_Stream(signal);
+}
+
+void firf_hp::Filter(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	Filter_Stream(signal, signal_size, filtered_signal, filtered_signal_size);
+
+	return;
+}
+
+void firf_hp::Load_Imp_Resp()
+{
 	if (!Valid_Freq_Cutoff_Parameter(_freq_cutoff, _samplerate)
 		|| !Valid_atten_Parameter(_atten))
 	{
 		throw parameter_error("Invalid filter parameter(s)");
 	}
-	std::vector<double> filt_sig;
-	auto filt_sig_size = Filtered_Signal_Size(signal.size(), filt_sig);
-	filt_sig = std::vector<double>(filt_sig_size, 0.0);
-	std::vector<double> imp_resp_causal = _imp_resp.Get_Causal_Imp_Resp(
-		_freq_cutoff, _atten);
-	std::vector<double> imp_resp = Get_Full_Imp_Resp(imp_resp_causal,
-		_delay_frac);
-	Normalize_Abs_Kahan(imp_resp);
-	ring_buffer buffer(_total_taps_max, _causal_taps_max);
-	long sample = 0;
-	while (sample < signal.size() && sample < filt_sig.size())
-	{
-		buffer.Insert(signal.at(sample));
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
-	}
-	while (sample < filt_sig.size())
-	{
-		buffer.Insert(0.0);
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
-	}
+	_imp_resp.Get_Causal_Imp_Resp(_freq_cutoff, _atten, _imp_resp_causal);
+	Get_Ring_Imp_Resp(_imp_resp_causal, _imp_resp_ring);
+	Normalize_Abs_Neumaier(_imp_resp_ring);
 
-	return filt_sig;
+	return;
 }
 
 bool firf_hp::Valid_Freq_Cutoff_Parameter(double freq_cutoff,
@@ -104,7 +100,7 @@ void firf_hp::Set_Imp_Resp()
 	// Req: Valid_Firf_Base()
 	double error_max_imp_resp = Error_Imp_Resp(_total_taps_max, _error_max);
 	_imp_resp.Configure(_samplerate, error_max_imp_resp, _win_pow,
-		_causal_taps_max);
+		_causal_taps_max, _wvt_lookup);
 
 	return;
 }
@@ -1,7 +1,7 @@
 #include "firf_hp_tmp.h"
 
 firf_hp_tmp::firf_hp_tmp() :
-	firf_base(), _freq_cutoff(nullptr), _atten(nullptr) {}
+	firf_tmp_base(), _farrow(false) {}
 
 firf_hp_tmp::firf_hp_tmp(double samplerate, double error_max,
 	double freq_min, double win_pow, double delay_frac) :
@@ -22,6 +22,7 @@ void firf_hp_tmp::Configure(double samplerate, double error_max,
 	std::vector<double> const* atten)
 {
 	auto temp_firf = std::make_unique<firf_hp_tmp>();
+	temp_firf->_wvt_lookup = _wvt_lookup;
 	temp_firf->Set_Base_Configs(samplerate, error_max,
 		freq_min, win_pow, delay_frac);
 	temp_firf->Set_Imp_Resp();
@@ -43,6 +44,27 @@ void firf_hp_tmp::Set_Parameters(std::vector<double> const* freq_cutoff,
 	{
 		throw parameter_error("Invalid filter parameters");
 	}
+	_freq_cutoff = param_env(freq_cutoff);
+	_atten = param_env(atten);
+
+	return;
+}
+
+void firf_hp_tmp::Set_Parameters(param_env const& freq_cutoff,
+	param_env const& atten)
+{
+	// Prom: generator values are checked when their response is loaded
+	if (!Valid_Samplerate(_samplerate))
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (!freq_cutoff.Valid_Values([this](double freq)
+		{ return _imp_resp.Valid_Freq_Input(freq); })
+		|| !atten.Valid_Values([this](double atten_frac)
+		{ return _imp_resp.Valid_atten_Frac(atten_frac); }))
+	{
+		throw parameter_error("Invalid filter parameters");
+	}
 	_freq_cutoff = freq_cutoff;
 	_atten = atten;
 
@@ -51,70 +73,103 @@ void firf_hp_tmp::Set_Parameters(std::vector<double> const* freq_cutoff,
 
 std::vector<double> firf_hp_tmp::Filter(std::vector<double> const& signal)
 {
+	if (!_farrow) { return Filter_Temporal(signal); }
 	if (!Valid_Firf_Base())
 	{
 		throw config_error("Invalid filter configuration");
 	}
-	if (_freq_cutoff == nullptr || _atten == nullptr)
-	{
-		throw parameter_error("Invalid filter parameter(s)");
-	}
 	std::vector<double> filt_sig;
 	auto filt_sig_size = Filtered_Signal_Size(signal.size(), filt_sig);
 	filt_sig = std::vector<double>(filt_sig_size, 0.0);
-	double freq_cutoff = 0.0;
-	double atten = 0.0;
-	std::tie(freq_cutoff, atten) = Get_Parameters(0, 0, signal.size());
-	std::vector<double> imp_resp_causal = _imp_resp.Get_Causal_Imp_Resp(
-		freq_cutoff, atten);
-	std::vector<double> imp_resp = Get_Full_Imp_Resp(imp_resp_causal,
-		_delay_frac);
-	Normalize_Abs_Kahan(imp_resp);
-	ring_buffer buffer(_total_taps_max, _causal_taps_max);
-	long sample = 0;
-	long load_samples = (_total_taps_max - _causal_taps_max)
-		- (static_cast<long>(imp_resp.size())
-		- static_cast<long>(imp_resp_causal.size()));
-	while (sample < load_samples && sample < signal.size()
-		&& sample < filt_sig.size())
+	Filter(signal.data(), static_cast<long>(signal.size()), filt_sig.data(),
+		static_cast<long>(filt_sig.size()));
+
+	return filt_sig;
+}
+
+void firf_hp_tmp::Filter(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	if (!_farrow)
 	{
-		buffer.Insert(signal.at(sample));
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
+		Filter_Temporal(signal, signal_size, filtered_signal,
+			filtered_signal_size);
+		return;
 	}
-	while (sample < load_samples)
+	if (Valid_Parameters() && !_atten.Constant())
 	{
-		buffer.Insert(0.0);
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
+		throw parameter_error("Farrow engine needs a constant attenuation");
 	}
-	while (sample < signal.size() && sample < filt_sig.size())
+	Filter_Farrow(signal, signal_size, filtered_signal,
+		filtered_signal_size);
+
+	return;
+}
+
+void firf_hp_tmp::Set_Farrow(bool farrow)
+{
+	// Prom: Filter(...) evaluates taps fitted as polynomials in the cutoff
+	// instead of synthesizing a response per cutoff
+	_farrow = farrow;
+
+	return;
+}
+
+bool firf_hp_tmp::Get_Farrow() const
+{
+	return _farrow;
+}
+
+bool firf_hp_tmp::Valid_Parameters() const
+{
+	if (_freq_cutoff.Valid_Param_Env() && _atten.Valid_Param_Env())
 	{
-		std::tie(freq_cutoff, atten) =
-			Get_Parameters(sample, load_samples, signal.size());
-		imp_resp_causal = _imp_resp.Get_Causal_Imp_Resp(freq_cutoff, atten);
-		imp_resp = Get_Full_Imp_Resp(imp_resp_causal, _delay_frac);
-		Normalize_Abs_Kahan(imp_resp);
-		buffer.Insert(signal.at(sample));
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
+		return true;
 	}
-	while (sample < filt_sig.size())
+	return false;
+}
+
+firf_tmp_base::kernel_key firf_hp_tmp::Temporal_Kernel_Key(long curr_sample,
+	long load_samples, long signal_size) const
+{
+	double freq_cutoff = 0.0;
+	double atten = 0.0;
+	std::tie(freq_cutoff, atten) =
+		Get_Parameters(curr_sample, load_samples, signal_size);
+
+	return std::make_tuple(freq_cutoff, atten, 0.0);
+}
+
+bool firf_hp_tmp::Valid_Kernel_Key(kernel_key const& key) const
+{
+	// Prom: key is (freq_cutoff, atten, 0.0)
+	if (_imp_resp.Valid_Freq_Input(std::get<0>(key))
+		&& _imp_resp.Valid_atten_Frac(std::get<1>(key))
+		&& std::get<2>(key) == 0.0)
 	{
-		buffer.Insert(0.0);
-		double processed_sample = buffer.Process_Cycle(imp_resp,
-			imp_resp_causal);
-		filt_sig.at(sample) = processed_sample;
-		sample++;
+		return true;
 	}
+	return false;
+}
 
-	return filt_sig;
+void firf_hp_tmp::Synthesize_Imp_Resp(kernel_key const& key)
+{
+	_imp_resp.Get_Causal_Imp_Resp(std::get<0>(key), std::get<1>(key),
+		_imp_resp_causal);
+	Get_Ring_Imp_Resp(_imp_resp_causal, _imp_resp_ring);
+	Normalize_Abs_Neumaier(_imp_resp_ring);
+
+	return;
+}
+
+void firf_hp_tmp::Synthesize_Exact_Imp_Resp(kernel_key const& key)
+{
+	_imp_resp_exact.Get_Causal_Imp_Resp(std::get<0>(key), std::get<1>(key),
+		_imp_resp_causal);
+	Get_Ring_Imp_Resp(_imp_resp_causal, _imp_resp_ring);
+	Normalize_Abs_Neumaier(_imp_resp_ring);
+
+	return;
 }
 
 bool firf_hp_tmp::Valid_Freq_Cutoff_Parameter(
@@ -156,7 +211,9 @@ void firf_hp_tmp::Set_Imp_Resp()
 	// Req: Valid_Firf_Base()
 	double error_max_imp_resp = Error_Imp_Resp(_total_taps_max, _error_max);
 	_imp_resp.Configure(_samplerate, error_max_imp_resp, _win_pow,
-		_causal_taps_max);
+		_causal_taps_max, _wvt_lookup);
+	_imp_resp_exact.Configure(_samplerate, error_max_imp_resp, _win_pow,
+		_causal_taps_max, wvt_lookup::direct);
 
 	return;
 }
@@ -164,17 +221,11 @@ void firf_hp_tmp::Set_Imp_Resp()
 std::tuple<double, double> firf_hp_tmp::Get_Parameters(long curr_sample,
 	long load_samples, std::vector<double>::size_type signal_size) const
 {
-	// Req: Valid_Freq_Cutoff_Parameter(_freq_cutoff, _samplerate)
+	// Req: Valid_Parameters()
 	// Req: Filtered_Signal_Size(signal_size, ...)
 	long rel_sample = curr_sample - load_samples;
-	double rel_sample_fp = static_cast<double>(rel_sample);
-	double signal_size_fp = static_cast<double>(signal_size);
-	double temporal_frac = rel_sample_fp / signal_size_fp;
-	double freq_c_size_fp = static_cast<double>(_freq_cutoff->size());
-	double atten_size_fp = static_cast<double>(_atten->size());
-	long freq_c_index = static_cast<long>(temporal_frac * freq_c_size_fp);
-	long atten_index = static_cast<long>(temporal_frac * atten_size_fp);
-
-	return std::make_tuple(_freq_cutoff->at(freq_c_index),
-		_atten->at(atten_index));
+	long signal_samples = static_cast<long>(signal_size);
+
+	return std::make_tuple(_freq_cutoff.Value(rel_sample, signal_samples),
+		_atten.Value(rel_sample, signal_samples));
 }
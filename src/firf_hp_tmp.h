@@ -9,15 +9,18 @@
 #include <vector>
 
 #include "errors_custom.h"
-#include "firf_base.h"
+#include "firf_tmp_base.h"
 #include "imp_resp_hp.h"
+#include "param_env.h"
 
-class firf_hp_tmp : public firf_base
+class firf_hp_tmp : public firf_tmp_base
 {
 private:
-	std::vector<double> const* _freq_cutoff;
-	std::vector<double> const* _atten;
+	param_env _freq_cutoff;
+	param_env _atten;
 	imp_resp_hp _imp_resp;
+	imp_resp_hp _imp_resp_exact;
+	bool _farrow;
 
 public:
 	firf_hp_tmp();
@@ -31,13 +34,27 @@ public:
 		std::vector<double> const* atten);
 	void Set_Parameters(std::vector<double> const* freq_cutoff,
 		std::vector<double> const* atten);
+	void Set_Parameters(param_env const& freq_cutoff,
+		param_env const& atten);
 	std::vector<double> Filter(std::vector<double> const& signal) override;
+	void Filter(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size) override;
+	void Set_Farrow(bool farrow);
+	bool Get_Farrow() const;
+
+protected:
+	bool Valid_Parameters() const override;
+	bool Valid_Kernel_Key(kernel_key const& key) const override;
+	kernel_key Temporal_Kernel_Key(long curr_sample, long load_samples,
+		long signal_size) const override;
+	void Synthesize_Imp_Resp(kernel_key const& key) override;
+	void Synthesize_Exact_Imp_Resp(kernel_key const& key) override;
 
 private:
 	bool Valid_Freq_Cutoff_Parameter(std::vector<double> const* freq_cutoff,
 		double samplerate) const;
 	bool Valid_atten_Parameter(std::vector<double> const* atten) const;
-	void Set_Imp_Resp();
+	void Set_Imp_Resp() override;
 	std::tuple<double, double> Get_Parameters(long curr_sample,
 		long load_samples, std::vector<double>::size_type signal_size) const;
 };
\ No newline at end of file
@@ -23,10 +23,15 @@ public:
 	void Configure(double samplerate, double error_max, double freq_min,
 		double win_pow, double delay_frac, double freq_cutoff, double atten);
 	std::vector<double> Filter(std::vector<double> const& signal) override;
+	void Filter(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size) override;
+
+protected:
+	void Load_Imp_Resp() override;
 
 private:
 	bool Valid_Freq_Cutoff_Parameter(double freq_cutoff,
 		double samplerate) const;
 	bool Valid_Atten_Parameter(double atten) const;
-	void Set_Imp_Resp();
+	void Set_Imp_Resp() override;
 };
\ No newline at end of file
@@ -0,0 +1,1480 @@
+#include "firf_tmp_base.h"
+
+// Kernel cache
+//
+// Get_Parameters(...) of the temporal filters maps every sample to the
+// nearest element of the parameter vectors, so long runs of samples share
+// one parameter tuple and a sweep revisits a limited set of tuples. The
+// normalized ring order impulse response of a tuple is kept in a cache of
+// at most Get_Kernel_Cache_Capacity() kernels, the least recently used
+// kernel is replaced when it is full. Samples with the tuple of the loaded
+// kernel cost no lookup. Cached kernels are bitwise equal to synthesized
+// ones, so the cache does not change the result.
+//
+// Constant spans
+//
+// Outside control_mode::interpolate the response only changes at the
+// control samples whose parameter tuple differs from the previous one.
+// Filter_Spans(...) looks ahead over the tuples for the next change, loads
+// one response per run of equal tuples and filters the run in blocks with
+// the tiled kernel of ring_buffer::Process_Cycles(...), the path of the
+// constant parameter filters. The responses are the same as per sample
+// loading, only the summation order of the outputs differs.
+//
+// Control rate
+//
+// With a control rate of K samples the impulse response is only loaded
+// every K samples of the signal. control_mode::hold keeps it until the
+// next control sample. control_mode::interpolate also loads the response
+// of the next control sample and interpolates linearly tap by tap between
+// the two, the responses aligned on their zeroth causal tap. Responses of
+// different causal sizes do not mirror their non causal taps over the
+// common size when 0 < delay_frac < 1, those intervals use the unfolded
+// dot product. control_mode::crossfade keeps the response of a control
+// sample as hold does; for the first Get_Crossfade_Length() samples of a
+// period the output of the previous response is computed as well and
+// faded linearly into the output of the new one. Every mode trades
+// accuracy for synthesis cost, which Measure_Control_Error(...) reports
+// relative to error_max.
+//
+// Kernel bank
+//
+// Set_Kernel_Bank(...) synthesizes the normalized responses of a grid
+// covering a box of parameter tuples, and tuples inside the box load the
+// response of the nearest grid point instead of synthesizing one. Each
+// axis of the grid is first refined on its own by bisection, with the
+// other parameters at the low end of their range where the responses are
+// longest: an interval is split while the response at its midpoint
+// differs from the response at either end by more than error_max in sum
+// of absolute tap differences. The grid is the product of the axes, and
+// Refine_Bank_Cells(...) then checks every cell of it: while the response
+// at a cell centre differs from the response at any corner of the cell
+// by more than error_max, the axis along which the response changes most
+// from the low corner is split at the cell middle. The centre is the
+// point farthest from every grid point, so for responses monotonic within
+// a cell the nearest point bounds the output difference for input in
+// [-1.0, 1.0].
+//
+// Heterodyne
+//
+// A band-pass or band-elimination response is a prototype p (the
+// response for a centre frequency of 0 Hz) times cos(w k), and
+//
+//   sum p(k) cos(w k) x(m - k)
+//     = Re{ e^(j phi(m)) sum p(k) e^(-j phi(m - k)) x(m - k) }
+//
+// whenever phi(m) - phi(m - k) = w k. Filter_Heterodyne(...) mixes the
+// input down with the phase phi(i) = w i, filters the in phase and
+// quadrature channels with the fixed prototype through the tiled kernel
+// and mixes the output back up with the phase of the output's centre
+// sample. Both mixers accumulate the same phase step from the same start,
+// so their phases agree exactly, and the output is the band response
+// within the cosine table error. The prototype is scaled like the
+// normalized response of the parameters.
+//
+// The identity needs a constant w. A moving centre frequency makes
+// phi(m) - phi(m - k) differ from the w k of the output's response, and
+// the normalization of the band response changes with w; a 2 to 8 kHz
+// sweep over 20000 samples with a 400 Hz bandwidth differed from the per
+// sample responses by 0.035 whatever error_max. Such a signal is filtered
+// by Filter_Temporal(...) instead.
+//
+// Farrow structure
+//
+// When only the first parameter f (the cutoff) moves, every tap of the
+// normalized response is a smooth function of f: the responses are one
+// windowed sinc scaled in time, and the taps a longer response adds start
+// from the zero of the window. Fit_Farrow(...) covers the cutoffs the
+// envelope reaches over the signal with segments, fitted again when a
+// later signal leaves them, and fits each tap, in the ring layout of
+// the longest response, with a polynomial of degree Farrow_Order in the
+// position u [-1, 1] of f within its segment, interpolating the responses
+// at the Chebyshev nodes. The responses are synthesized with
+// wvt_lookup::direct: table responses step with f wherever the lookup
+// moves to another element, by up to error_max, which no polynomial
+// follows. Segments are half open, [low, high). A segment is halved while
+// the polynomial taps differ from the exact response by more than
+// error_max in summed absolute tap difference at its ends or between its
+// nodes, which bounds the output error for input in [-1.0, 1.0] as the
+// kernel path does; the high end is checked one double below high. The
+// taps step where the size of the response changes (the window is
+// stretched over the new size, and 0 < delay_frac < 1 cuts off non causal
+// taps), so a segment of relative width 1e-9 that still fails is split at
+// the first double of the new size, found by bisection. A segment without
+// a size step that cannot reach error_max throws config_error: the high
+// pass response within about 1e-4 Hz of samplerate / 2 is the difference
+// of nearly equal terms, and its normalized taps are rounding noise.
+//
+// Filtering then needs no synthesis: each sample is the Horner evaluation
+// in u of the Farrow_Order + 1 outputs of the segment's coefficient
+// filters, which the tiled kernel computes over runs of samples in one
+// segment. The coefficient filters do not mirror, so they take the
+// unfolded product over all taps.
+
+firf_tmp_base::firf_tmp_base() :
+	firf_base(), _kernel_cache_capacity(Kernel_Cache_Capacity_Default),
+	_kernel_cache_clock(0), _kernel_cache_loaded(-1), _kernel_cache_hits(0),
+	_kernel_cache_misses(0), _control_rate(1),
+	_control_mode(control_mode::interpolate), _control_span(0),
+	_control_causal(0), _control_folded(true), _control_causal_a(0),
+	_control_causal_b(0), _crossfade_length(Crossfade_Length_Default),
+	_kernel_bank_loaded(-1), _farrow_cursor(0) {}
+
+void firf_tmp_base::Set_Kernel_Cache_Capacity(long kernels)
+{
+	// Prom: 0 disables the cache, the cache is cleared in any case
+	if (kernels < 0)
+	{
+		throw parameter_error("Invalid kernel cache capacity");
+	}
+	_kernel_cache_capacity = kernels;
+	Clear_Kernel_Cache();
+
+	return;
+}
+
+long firf_tmp_base::Get_Kernel_Cache_Capacity() const
+{
+	return _kernel_cache_capacity;
+}
+
+long firf_tmp_base::Get_Kernel_Cache_Hits() const
+{
+	return _kernel_cache_hits;
+}
+
+long firf_tmp_base::Get_Kernel_Cache_Misses() const
+{
+	return _kernel_cache_misses;
+}
+
+double firf_tmp_base::Get_Kernel_Cache_Hit_Rate() const
+{
+	// Prom: hits / (hits + misses) since the last Clear_Kernel_Cache(),
+	// 0.0 before any kernel has been requested
+	long requests = _kernel_cache_hits + _kernel_cache_misses;
+	if (requests == 0) { return 0.0; }
+
+	return static_cast<double>(_kernel_cache_hits)
+		/ static_cast<double>(requests);
+}
+
+void firf_tmp_base::Clear_Kernel_Cache()
+{
+	_kernel_cache_keys.clear();
+	_kernel_cache_last_use.clear();
+	_kernel_cache_causal.clear();
+	_kernel_cache_ring.clear();
+	_kernel_cache_index.clear();
+	_kernel_cache_clock = 0;
+	_kernel_cache_loaded = -1;
+	_kernel_cache_hits = 0;
+	_kernel_cache_misses = 0;
+
+	return;
+}
+
+void firf_tmp_base::Set_Control_Rate(long samples, control_mode mode)
+{
+	// Prom: the impulse response is loaded every samples samples, 1 (the
+	// default) loads it for every sample
+	if (samples < 1)
+	{
+		throw parameter_error("Invalid control rate");
+	}
+	_control_rate = samples;
+	_control_mode = mode;
+
+	return;
+}
+
+long firf_tmp_base::Get_Control_Rate() const
+{
+	return _control_rate;
+}
+
+control_mode firf_tmp_base::Get_Control_Mode() const
+{
+	return _control_mode;
+}
+
+void firf_tmp_base::Set_Crossfade_Length(long samples)
+{
+	// Prom: control_mode::crossfade fades over samples samples, at most
+	// the control rate
+	if (samples < 1)
+	{
+		throw parameter_error("Invalid crossfade length");
+	}
+	_crossfade_length = samples;
+
+	return;
+}
+
+long firf_tmp_base::Get_Crossfade_Length() const
+{
+	return _crossfade_length;
+}
+
+double firf_tmp_base::Measure_Control_Error(
+	std::vector<double> const& signal)
+{
+	// Req: signal in [-1.0, 1.0], the range error_max bounds
+	// Prom: largest absolute difference between Filter(signal) at the
+	// control rate and with the response loaded every sample, divided by
+	// error_max, <= 1.0 when the control rate stays within error_max
+	std::vector<double> controlled = Filter_Temporal(signal);
+	long control_rate = _control_rate;
+	control_mode mode = _control_mode;
+	_control_rate = 1;
+	_control_mode = control_mode::hold;
+	std::vector<double> reference;
+	try
+	{
+		reference = Filter_Temporal(signal);
+	}
+	catch (...)
+	{
+		_control_rate = control_rate;
+		_control_mode = mode;
+		throw;
+	}
+	_control_rate = control_rate;
+	_control_mode = mode;
+	double error = 0.0;
+	for (std::vector<double>::size_type sample = 0;
+		sample < reference.size(); sample++)
+	{
+		error = std::max(error,
+			std::abs(controlled[sample] - reference[sample]));
+	}
+
+	return error / _error_max;
+}
+
+void firf_tmp_base::Set_Kernel_Bank(kernel_key const& low,
+	kernel_key const& high)
+{
+	// Req: Valid_Firf_Base(), the tuples as Get_Parameters(...) returns
+	// them, unused tuple elements 0.0
+	// Prom: strong exception safety, the bank is replaced on success
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (!Valid_Kernel_Key(low) || !Valid_Kernel_Key(high))
+	{
+		throw parameter_error("Invalid kernel bank range");
+	}
+	for (long axis = 0; axis < 3; axis++)
+	{
+		if (Key_Value(low, axis) > Key_Value(high, axis))
+		{
+			throw parameter_error("Invalid kernel bank range");
+		}
+	}
+	// _imp_resp_* are overwritten by the synthesis from here on
+	_kernel_bank_loaded = -1;
+	_kernel_cache_loaded = -1;
+	std::vector<std::vector<double>> axes(3);
+	for (long axis = 0; axis < 3; axis++)
+	{
+		Refine_Bank_Axis(low, axis, Key_Value(high, axis), axes[axis]);
+	}
+	std::map<kernel_key, long> synthesized;
+	std::vector<std::vector<double>> synth_ring;
+	std::vector<long> synth_causal;
+	while (Refine_Bank_Cells(axes, synthesized, synth_ring, synth_causal))
+	{
+	}
+	long kernels = static_cast<long>(axes[0].size() * axes[1].size()
+		* axes[2].size());
+	std::vector<std::vector<double>> ring(kernels);
+	std::vector<long> causal(kernels, 0);
+	for (long kernel = 0; kernel < kernels; kernel++)
+	{
+		long index_0 = kernel % static_cast<long>(axes[0].size());
+		long rest = kernel / static_cast<long>(axes[0].size());
+		long index_1 = rest % static_cast<long>(axes[1].size());
+		long index_2 = rest / static_cast<long>(axes[1].size());
+		long entry = Bank_Imp_Resp(std::make_tuple(axes[0][index_0],
+			axes[1][index_1], axes[2][index_2]), synthesized, synth_ring,
+			synth_causal);
+		ring[kernel] = std::move(synth_ring[entry]);
+		causal[kernel] = synth_causal[entry];
+	}
+	_kernel_bank_axes = std::move(axes);
+	_kernel_bank_ring = std::move(ring);
+	_kernel_bank_causal = std::move(causal);
+
+	return;
+}
+
+void firf_tmp_base::Clear_Kernel_Bank()
+{
+	_kernel_bank_axes.clear();
+	_kernel_bank_ring.clear();
+	_kernel_bank_causal.clear();
+	_kernel_bank_loaded = -1;
+
+	return;
+}
+
+long firf_tmp_base::Get_Farrow_Segments() const
+{
+	return static_cast<long>(_farrow_low.size());
+}
+
+long firf_tmp_base::Get_Farrow_Bytes() const
+{
+	// Prom: memory held by the coefficient filters and segment bounds
+	long bytes = static_cast<long>((_farrow_low.capacity()
+		+ _farrow_high.capacity()) * sizeof(double));
+	for (auto const& coeffs : _farrow_coeffs)
+	{
+		bytes += static_cast<long>(coeffs.capacity() * sizeof(double)
+			+ sizeof(coeffs));
+	}
+
+	return bytes;
+}
+
+long firf_tmp_base::Get_Kernel_Bank_Kernels() const
+{
+	return static_cast<long>(_kernel_bank_ring.size());
+}
+
+long firf_tmp_base::Get_Kernel_Bank_Bytes() const
+{
+	// Prom: memory held by the bank responses, grid and sizes
+	long bytes = 0;
+	for (auto const& axis : _kernel_bank_axes)
+	{
+		bytes += static_cast<long>(axis.capacity() * sizeof(double));
+	}
+	for (auto const& ring : _kernel_bank_ring)
+	{
+		bytes += static_cast<long>(ring.capacity() * sizeof(double)
+			+ sizeof(ring));
+	}
+	bytes += static_cast<long>(_kernel_bank_causal.capacity() * sizeof(long));
+
+	return bytes;
+}
+
+std::vector<double> firf_tmp_base::Filter_Temporal(
+	std::vector<double> const& signal)
+{
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	std::vector<double> filt_sig;
+	auto filt_sig_size = Filtered_Signal_Size(signal.size(), filt_sig);
+	filt_sig = std::vector<double>(filt_sig_size, 0.0);
+	Filter_Temporal(signal.data(), static_cast<long>(signal.size()),
+		filt_sig.data(), static_cast<long>(filt_sig.size()));
+
+	return filt_sig;
+}
+
+void firf_tmp_base::Filter_Temporal(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	// Prom: impulse response is loaded every Get_Control_Rate() signal
+	// samples, from the kernel cache when its parameter tuple has been
+	// synthesized before
+	// Prom: no allocation once the kernel cache is full, the largest
+	// impulse response has been synthesized and the ring buffer sized for
+	// the current configuration
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (!Valid_Parameters())
+	{
+		throw parameter_error("Invalid filter parameter(s)");
+	}
+	if (filtered_signal_size != Get_Filtered_Signal_Size(signal_size)
+		|| (signal_size > 0 && signal == nullptr)
+		|| filtered_signal == nullptr)
+	{
+		throw parameter_error("Invalid signal or filtered signal size");
+	}
+	if (signal_size == 0)
+	{
+		// No parameter sample to load, only the tail of zero input
+		std::fill(filtered_signal, filtered_signal + filtered_signal_size,
+			0.0);
+		return;
+	}
+	if (_control_mode != control_mode::interpolate || _control_rate == 1)
+	{
+		Filter_Spans(signal, signal_size, filtered_signal,
+			filtered_signal_size);
+		return;
+	}
+	Load_Temporal_Imp_Resp(0, 0, signal_size);
+	_control_folded = true;
+	Reset_Ring_Buffer();
+	long sample = 0;
+	long load_samples = (_total_taps_max - _causal_taps_max)
+		- (static_cast<long>(_imp_resp_ring.size())
+		- static_cast<long>(_imp_resp_causal.size()));
+	while (sample < load_samples && sample < signal_size)
+	{
+		_ring_buffer.Insert(signal[sample]);
+		filtered_signal[sample] = Process_Temporal_Cycle();
+		sample++;
+	}
+	while (sample < load_samples)
+	{
+		_ring_buffer.Insert(0.0);
+		filtered_signal[sample] = Process_Temporal_Cycle();
+		sample++;
+	}
+	while (sample < signal_size)
+	{
+		Load_Control_Imp_Resp(sample, load_samples, signal_size);
+		_ring_buffer.Insert(signal[sample]);
+		filtered_signal[sample] = Process_Temporal_Cycle();
+		sample++;
+	}
+	while (sample < filtered_signal_size)
+	{
+		_ring_buffer.Insert(0.0);
+		filtered_signal[sample] = Process_Temporal_Cycle();
+		sample++;
+	}
+
+	return;
+}
+
+void firf_tmp_base::Load_Control_Imp_Resp(long curr_sample,
+	long load_samples, long signal_size)
+{
+	// Req: control_mode::interpolate, curr_sample [load_samples,
+	// signal_size), called for every sample in order
+	long phase = (curr_sample - load_samples) % _control_rate;
+	if (phase == 0)
+	{
+		Start_Control_Interval(curr_sample, load_samples, signal_size);
+	}
+	double frac = 0.0;
+	if (_control_span > 0)
+	{
+		frac = static_cast<double>(phase)
+			/ static_cast<double>(_control_span);
+	}
+	Interpolate_Control_Imp_Resp(frac);
+
+	return;
+}
+
+void firf_tmp_base::Start_Control_Interval(long curr_sample,
+	long load_samples, long signal_size)
+{
+	// Prom: _control_base and _control_slope hold the response of
+	// curr_sample and its difference to the response of the next control
+	// sample, both aligned on the zeroth causal tap
+	// Prom: one response synthesis per interval, the response of the
+	// next control sample is kept for the following interval
+	if (curr_sample == load_samples)
+	{
+		Load_Temporal_Imp_Resp(curr_sample, load_samples, signal_size);
+		_control_ring_b.assign(_imp_resp_ring.begin(), _imp_resp_ring.end());
+		_control_causal_b = static_cast<long>(_imp_resp_causal.size());
+	}
+	std::swap(_control_ring_a, _control_ring_b);
+	_control_causal_a = _control_causal_b;
+	long next_sample = std::min(curr_sample + _control_rate,
+		signal_size - 1);
+	_control_span = next_sample - curr_sample;
+	if (_control_span > 0)
+	{
+		Load_Temporal_Imp_Resp(next_sample, load_samples, signal_size);
+		_control_ring_b.assign(_imp_resp_ring.begin(), _imp_resp_ring.end());
+		_control_causal_b = static_cast<long>(_imp_resp_causal.size());
+	}
+	else
+	{
+		_control_ring_b.assign(_control_ring_a.begin(),
+			_control_ring_a.end());
+		_control_causal_b = _control_causal_a;
+	}
+	// _imp_resp_* are overwritten by the interpolation from here on
+	_kernel_cache_loaded = -1;
+	_kernel_bank_loaded = -1;
+
+	long causal = std::max(_control_causal_a, _control_causal_b);
+	long non_causal = static_cast<long>((causal - 1) * _delay_frac);
+	long total = causal + non_causal;
+	_control_base.assign(total, 0.0);
+	_control_slope.assign(total, 0.0);
+	long offset_a = causal - _control_causal_a;
+	long offset_b = causal - _control_causal_b;
+	for (long tap = 0; tap < static_cast<long>(_control_ring_a.size()); tap++)
+	{
+		_control_base[offset_a + tap] = _control_ring_a[tap];
+	}
+	for (long tap = 0; tap < static_cast<long>(_control_ring_b.size()); tap++)
+	{
+		_control_slope[offset_b + tap] = _control_ring_b[tap];
+	}
+	for (long tap = 0; tap < total; tap++)
+	{
+		_control_slope[tap] -= _control_base[tap];
+	}
+	long non_causal_a = static_cast<long>(_control_ring_a.size())
+		- _control_causal_a;
+	long non_causal_b = static_cast<long>(_control_ring_b.size())
+		- _control_causal_b;
+	_control_folded = (non_causal_a == non_causal
+		|| non_causal_a == _control_causal_a - 1)
+		&& (non_causal_b == non_causal
+		|| non_causal_b == _control_causal_b - 1);
+	_control_causal = causal;
+
+	return;
+}
+
+void firf_tmp_base::Interpolate_Control_Imp_Resp(double frac)
+{
+	// Req: Start_Control_Interval(...)
+	// Prom: no allocation once _imp_resp_* hold _total_taps_max taps
+	long total = static_cast<long>(_control_base.size());
+	_imp_resp_ring.resize(total);
+	for (long tap = 0; tap < total; tap++)
+	{
+		_imp_resp_ring[tap] = _control_base[tap] + frac * _control_slope[tap];
+	}
+	_imp_resp_causal.resize(_control_causal);
+	for (long tap = 0; tap < _control_causal; tap++)
+	{
+		_imp_resp_causal[tap] = _imp_resp_ring[_control_causal - 1 - tap];
+	}
+
+	return;
+}
+
+double firf_tmp_base::Heterodyne_Step(wvt_cos const& cos_wvt,
+	long signal_size) const
+{
+	// Prom: phase step per sample of the constant centre frequency
+	kernel_key key = Temporal_Kernel_Key(0, 0, signal_size);
+	if (!Valid_Kernel_Key(key))
+	{
+		throw parameter_error("Invalid filter parameter(s)");
+	}
+
+	return cos_wvt.Position_Step(std::get<0>(key));
+}
+
+void firf_tmp_base::Fit_Farrow(kernel_key const& key, double freq_low,
+	double freq_high)
+{
+	// Req: Valid_Kernel_Key(...) over the first element [freq_low,
+	// freq_high] with the other elements of key
+	// Prom: segments covering [freq_low, freq_high]
+	_farrow_low.clear();
+	_farrow_high.clear();
+	_farrow_coeffs.clear();
+	_farrow_cursor = 0;
+	Fit_Farrow_Interval(key, freq_low, std::nextafter(freq_high, HUGE_VAL),
+		Farrow_Basis());
+	_farrow_key = key;
+	_kernel_cache_loaded = -1;
+	_kernel_bank_loaded = -1;
+
+	return;
+}
+
+void firf_tmp_base::Fit_Farrow_Interval(kernel_key const& key, double low,
+	double high, std::vector<double> const& basis)
+{
+	// Prom: segments covering [low, high) in order, see the top of file
+	// Prom: config_error when a segment cannot reach error_max
+	long terms = Farrow_Order + 1;
+	double middle = 0.5 * (low + high);
+	double half = 0.5 * (high - low);
+	std::vector<std::vector<double>> nodes(terms);
+	for (long node = 0; node < terms; node++)
+	{
+		double position = std::cos(PI_FIR * (2 * node + 1) / (2 * terms));
+		Farrow_Taps(key, middle + half * position, nodes[node]);
+	}
+	std::vector<std::vector<double>> coeffs(terms,
+		std::vector<double>(_total_taps_max, 0.0));
+	for (long power = 0; power < terms; power++)
+	{
+		for (long node = 0; node < terms; node++)
+		{
+			double weight = basis[node * terms + power];
+			for (long tap = 0; tap < _total_taps_max; tap++)
+			{
+				coeffs[power][tap] += weight * nodes[node][tap];
+			}
+		}
+	}
+
+	// Ends and points between the nodes
+	double distance = 0.0;
+	std::vector<double> taps;
+	double last = std::nextafter(high, low);
+	for (long point = 0; point <= terms && distance <= _error_max; point++)
+	{
+		double freq = std::max(low, std::min(last,
+			middle + half * std::cos(PI_FIR * point / terms)));
+		double position = (freq - middle) / half;
+		Farrow_Taps(key, freq, taps);
+		distance = 0.0;
+		for (long tap = 0; tap < _total_taps_max; tap++)
+		{
+			double value = coeffs[Farrow_Order][tap];
+			for (long power = Farrow_Order - 1; power >= 0; power--)
+			{
+				value = value * position + coeffs[power][tap];
+			}
+			distance += std::abs(value - taps[tap]);
+		}
+	}
+	if (distance > _error_max && half > 0.5e-9 * high)
+	{
+		Fit_Farrow_Interval(key, low, middle, basis);
+		Fit_Farrow_Interval(key, middle, high, basis);
+		return;
+	}
+	if (distance > _error_max)
+	{
+		double step = Farrow_Step(key, low, high);
+		if (step <= low)
+		{
+			throw config_error("Farrow fit cannot reach error_max");
+		}
+		Fit_Farrow_Interval(key, low, step, basis);
+		Fit_Farrow_Interval(key, step, high, basis);
+		return;
+	}
+	_farrow_low.push_back(low);
+	_farrow_high.push_back(high);
+	for (auto& power_coeffs : coeffs)
+	{
+		_farrow_coeffs.push_back(std::move(power_coeffs));
+	}
+
+	return;
+}
+
+double firf_tmp_base::Farrow_Step(kernel_key key, double low, double high)
+{
+	// Prom: the first double in (low, high) with a response size other
+	// than the size at low, found by bisection, low when the size one
+	// double below high is the size at low
+	auto sizes = [this, &key](double freq)
+	{
+		Set_Key_Value(key, 0, freq);
+		Synthesize_Exact_Imp_Resp(key);
+		return std::make_pair(_imp_resp_ring.size(),
+			_imp_resp_causal.size());
+	};
+	auto low_sizes = sizes(low);
+	double upper = std::nextafter(high, low);
+	if (sizes(upper) == low_sizes) { return low; }
+	while (std::nextafter(low, upper) < upper)
+	{
+		double middle = low + 0.5 * (upper - low);
+		if (middle <= low || middle >= upper)
+		{
+			middle = std::nextafter(low, upper);
+		}
+		if (sizes(middle) == low_sizes) { low = middle; }
+		else { upper = middle; }
+	}
+
+	return upper;
+}
+
+void firf_tmp_base::Farrow_Taps(kernel_key key, double freq,
+	std::vector<double>& taps)
+{
+	// Prom: normalized exact response at freq in the ring layout of the
+	// longest response, aligned on the zeroth causal tap
+	Set_Key_Value(key, 0, freq);
+	Synthesize_Exact_Imp_Resp(key);
+	long offset = _causal_taps_max
+		- static_cast<long>(_imp_resp_causal.size());
+	taps.assign(_total_taps_max, 0.0);
+	std::copy(_imp_resp_ring.begin(), _imp_resp_ring.end(),
+		taps.begin() + offset);
+
+	return;
+}
+
+std::vector<double> firf_tmp_base::Farrow_Basis() const
+{
+	// Prom: basis[node * terms + power] is the coefficient of u^power in
+	// the Lagrange polynomial of the Chebyshev node, so the coefficients
+	// of the interpolating polynomial are the weighted sums of the values
+	long terms = Farrow_Order + 1;
+	std::vector<double> positions(terms);
+	for (long node = 0; node < terms; node++)
+	{
+		positions[node] = std::cos(PI_FIR * (2 * node + 1) / (2 * terms));
+	}
+	std::vector<double> basis(terms * terms, 0.0);
+	std::vector<double> poly(terms);
+	for (long node = 0; node < terms; node++)
+	{
+		std::fill(poly.begin(), poly.end(), 0.0);
+		poly[0] = 1.0;
+		long degree = 0;
+		for (long other = 0; other < terms; other++)
+		{
+			if (other == node) { continue; }
+			double scale = 1.0 / (positions[node] - positions[other]);
+			degree++;
+			for (long power = degree; power >= 0; power--)
+			{
+				double shifted = (power > 0) ? poly[power - 1] : 0.0;
+				poly[power] = (shifted - positions[other] * poly[power])
+					* scale;
+			}
+		}
+		for (long power = 0; power < terms; power++)
+		{
+			basis[node * terms + power] = poly[power];
+		}
+	}
+
+	return basis;
+}
+
+long firf_tmp_base::Farrow_Segment(double freq)
+{
+	// Prom: segment [low, high) containing freq, from the previous segment
+	// when it still does, parameter_error outside the fitted range
+	if (!(freq >= _farrow_low.front() && freq < _farrow_high.back()))
+	{
+		throw parameter_error("Cutoff outside the Farrow fit range");
+	}
+	if (freq >= _farrow_low[_farrow_cursor]
+		&& freq < _farrow_high[_farrow_cursor])
+	{
+		return _farrow_cursor;
+	}
+	auto after = std::upper_bound(_farrow_low.begin(), _farrow_low.end(),
+		freq);
+	_farrow_cursor = static_cast<long>(after - _farrow_low.begin()) - 1;
+
+	return _farrow_cursor;
+}
+
+void firf_tmp_base::Process_Farrow_Run(double const* signal, long count,
+	long segment, double const* positions, double* filtered_signal)
+{
+	// Req: count [1, _farrow_buffer.Block_Size()], signal == nullptr
+	// inserts zeros
+	// Prom: no allocation
+	if (signal == nullptr) { _farrow_buffer.Insert_Zeros(count); }
+	else { _farrow_buffer.Insert_Block(signal, count); }
+	long terms = Farrow_Order + 1;
+	long block_size = _farrow_buffer.Block_Size();
+	double* outputs = _farrow_block.data();
+	for (long power = 0; power < terms; power++)
+	{
+		std::vector<double> const& taps =
+			_farrow_coeffs[segment * terms + power];
+		_farrow_buffer.Process_Cycles(taps, taps, count,
+			outputs + power * block_size);
+	}
+	for (long index = 0; index < count; index++)
+	{
+		double value = outputs[Farrow_Order * block_size + index];
+		for (long power = Farrow_Order - 1; power >= 0; power--)
+		{
+			value = value * positions[index]
+				+ outputs[power * block_size + index];
+		}
+		filtered_signal[index] = value;
+	}
+
+	return;
+}
+
+double firf_tmp_base::Process_Temporal_Cycle()
+{
+	if (_control_folded)
+	{
+		return _ring_buffer.Process_Cycle(_imp_resp_ring, _imp_resp_causal);
+	}
+
+	return _ring_buffer.Process_Cycle_Unfolded(_imp_resp_ring,
+		_imp_resp_causal);
+}
+
+void firf_tmp_base::Filter_Spans(double const* signal,
+	long signal_size, double* filtered_signal, long filtered_signal_size)
+{
+	// Req: validated as Filter_Temporal(...), control_mode::hold,
+	// control_mode::crossfade or a control rate of 1
+	// Prom: the response of each control sample is used from that sample
+	// to the next control sample with a different parameter tuple, with
+	// control_mode::crossfade faded in from the previous response over
+	// min(Get_Crossfade_Length(), Get_Control_Rate()) samples
+	// Prom: one response load per run of equal tuples, the samples of a
+	// run are filtered by the tiled kernel
+	Load_Temporal_Imp_Resp(0, 0, signal_size);
+	kernel_key span_key = Temporal_Kernel_Key(0, 0, signal_size);
+	Reset_Ring_Buffer();
+	long load_samples = (_total_taps_max - _causal_taps_max)
+		- (static_cast<long>(_imp_resp_ring.size())
+		- static_cast<long>(_imp_resp_causal.size()));
+	bool crossfade = _control_mode == control_mode::crossfade;
+	long fade_length = std::min(_crossfade_length, _control_rate);
+	long fade_start = 0;
+	long fade_end = 0;
+	long change = load_samples;
+	long sample = 0;
+	while (sample < filtered_signal_size)
+	{
+		if (sample == change && sample < signal_size)
+		{
+			kernel_key key = Temporal_Kernel_Key(sample, load_samples,
+				signal_size);
+			if (key != span_key)
+			{
+				if (crossfade)
+				{
+					_fade_ring.assign(_imp_resp_ring.begin(),
+						_imp_resp_ring.end());
+					_fade_causal.assign(_imp_resp_causal.begin(),
+						_imp_resp_causal.end());
+					fade_start = sample;
+					fade_end = sample + fade_length;
+				}
+				Load_Kernel(key);
+				span_key = key;
+			}
+
+			// Run of control samples sharing the tuple
+			change = sample + _control_rate;
+			while (change < signal_size && Temporal_Kernel_Key(change,
+				load_samples, signal_size) == span_key)
+			{
+				change += _control_rate;
+			}
+		}
+
+		// Span up to the next response change, fade end or signal end
+		long span_end = std::min(filtered_signal_size,
+			sample + _ring_buffer.Block_Size());
+		if (sample < signal_size)
+		{
+			span_end = std::min(span_end, std::min(change, signal_size));
+		}
+		if (sample < fade_end) { span_end = std::min(span_end, fade_end); }
+		long count = span_end - sample;
+		double const* span_signal = nullptr;
+		if (sample < signal_size) { span_signal = signal + sample; }
+		long fade_position = -1;
+		if (sample < fade_end) { fade_position = sample - fade_start; }
+		Process_Span(span_signal, count, filtered_signal + sample,
+			fade_position, fade_length);
+		sample = span_end;
+	}
+
+	return;
+}
+
+void firf_tmp_base::Process_Span(double const* signal, long count,
+	double* filtered_signal, long fade_position, long fade_length)
+{
+	// Req: count [1, _ring_buffer.Block_Size()], signal == nullptr inserts
+	// zeros, fade_position < 0 outside a fade
+	// Prom: no allocation once _fade_* hold the largest response
+	if (signal == nullptr) { _ring_buffer.Insert_Zeros(count); }
+	else { _ring_buffer.Insert_Block(signal, count); }
+	_ring_buffer.Process_Cycles(_imp_resp_ring, _imp_resp_causal, count,
+		filtered_signal);
+	if (fade_position < 0) { return; }
+	_fade_output.resize(_ring_buffer.Block_Size());
+	_ring_buffer.Process_Cycles(_fade_ring, _fade_causal, count,
+		_fade_output.data());
+	double fade_size = static_cast<double>(fade_length + 1);
+	for (long index = 0; index < count; index++)
+	{
+		double weight = static_cast<double>(fade_position + index + 1)
+			/ fade_size;
+		filtered_signal[index] = _fade_output[index]
+			+ weight * (filtered_signal[index] - _fade_output[index]);
+	}
+
+	return;
+}
+
+void firf_tmp_base::Filter_Heterodyne(double const* signal,
+	long signal_size, double* filtered_signal, long filtered_signal_size,
+	wvt_cos const& cos_wvt)
+{
+	// Req: the first element of the parameter tuple is the centre
+	// frequency, constant over the signal, Load_Heterodyne_Imp_Resp(...)
+	// overridden
+	// Prom: no allocation after the first call with a configuration
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (!Valid_Parameters())
+	{
+		throw parameter_error("Invalid filter parameter(s)");
+	}
+	if (filtered_signal_size != Get_Filtered_Signal_Size(signal_size)
+		|| (signal_size > 0 && signal == nullptr)
+		|| filtered_signal == nullptr)
+	{
+		throw parameter_error("Invalid signal or filtered signal size");
+	}
+	if (signal_size == 0)
+	{
+		// No parameter sample to load, only the tail of zero input
+		std::fill(filtered_signal, filtered_signal + filtered_signal_size,
+			0.0);
+		return;
+	}
+	Load_Heterodyne_Imp_Resp(Temporal_Kernel_Key(0, 0, signal_size));
+	_kernel_cache_loaded = -1;
+	_kernel_bank_loaded = -1;
+	Reset_Ring_Buffer();
+	if (_heterodyne_buffer.Size() != _total_taps_max)
+	{
+		_heterodyne_buffer.Configure(_total_taps_max, _causal_taps_max);
+	}
+	else
+	{
+		_heterodyne_buffer.Clear();
+	}
+	_heterodyne_buffer.Set_Isa(_ring_buffer.Get_Isa());
+	long block_size = _ring_buffer.Block_Size();
+	_heterodyne_block.resize(4 * block_size);
+	double* in_phase = _heterodyne_block.data();
+	double* quadrature = in_phase + block_size;
+	double* in_phase_out = quadrature + block_size;
+	double* quadrature_out = in_phase_out + block_size;
+
+	// Output sample s is centred on input sample s - delay, phases are
+	// accumulated from input sample -delay on
+	long delay = _total_taps_max - _causal_taps_max;
+	double input_position = 0.0;
+	double output_position = 0.0;
+	double step = Heterodyne_Step(cos_wvt, signal_size);
+	for (long sample = -delay; sample < 0; sample++)
+	{
+		input_position = cos_wvt.Advance_Position(input_position, step);
+	}
+	long sample = 0;
+	while (sample < filtered_signal_size)
+	{
+		long count = std::min(block_size, filtered_signal_size - sample);
+		for (long index = 0; index < count; index++)
+		{
+			long input = sample + index;
+			double value = (input < signal_size) ? signal[input] : 0.0;
+			double cosine = 0.0;
+			double sine = 0.0;
+			cos_wvt.Get_Quadrature(input_position, cosine, sine);
+			in_phase[index] = value * cosine;
+			quadrature[index] = -value * sine;
+			input_position = cos_wvt.Advance_Position(input_position, step);
+		}
+		_ring_buffer.Insert_Block(in_phase, count);
+		_heterodyne_buffer.Insert_Block(quadrature, count);
+		_ring_buffer.Process_Cycles(_imp_resp_ring, _imp_resp_causal, count,
+			in_phase_out);
+		_heterodyne_buffer.Process_Cycles(_imp_resp_ring, _imp_resp_causal,
+			count, quadrature_out);
+		for (long index = 0; index < count; index++)
+		{
+			double cosine = 0.0;
+			double sine = 0.0;
+			cos_wvt.Get_Quadrature(output_position, cosine, sine);
+			filtered_signal[sample + index] = cosine * in_phase_out[index]
+				- sine * quadrature_out[index];
+			output_position = cos_wvt.Advance_Position(output_position,
+				step);
+		}
+		sample += count;
+	}
+
+	return;
+}
+
+void firf_tmp_base::Filter_Farrow(double const* signal, long signal_size,
+	double* filtered_signal, long filtered_signal_size)
+{
+	// Req: only the first element of the parameter tuple varies
+	// Prom: each output applies the fitted taps at the first element of
+	// the tuple the kernel path would load for it
+	// Prom: no allocation once fitted for the other tuple elements
+	if (!Valid_Firf_Base())
+	{
+		throw config_error("Invalid filter configuration");
+	}
+	if (!Valid_Parameters())
+	{
+		throw parameter_error("Invalid filter parameter(s)");
+	}
+	if (filtered_signal_size != Get_Filtered_Signal_Size(signal_size)
+		|| (signal_size > 0 && signal == nullptr)
+		|| filtered_signal == nullptr)
+	{
+		throw parameter_error("Invalid signal or filtered signal size");
+	}
+	if (signal_size == 0)
+	{
+		// No parameter sample to load, only the tail of zero input
+		std::fill(filtered_signal, filtered_signal + filtered_signal_size,
+			0.0);
+		return;
+	}
+	Load_Temporal_Imp_Resp(0, 0, signal_size);
+	long load_samples = (_total_taps_max - _causal_taps_max)
+		- (static_cast<long>(_imp_resp_ring.size())
+		- static_cast<long>(_imp_resp_causal.size()));
+	kernel_key fit_key = Temporal_Kernel_Key(0, 0, signal_size);
+	double freq_low = Key_Value(fit_key, 0);
+	double freq_high = freq_low;
+	for (long rel_sample = 1; rel_sample < signal_size - load_samples;
+		rel_sample++)
+	{
+		double freq = Key_Value(Temporal_Kernel_Key(rel_sample, 0,
+			signal_size), 0);
+		freq_low = std::min(freq_low, freq);
+		freq_high = std::max(freq_high, freq);
+	}
+	Set_Key_Value(fit_key, 0, 0.0);
+	if (_farrow_low.empty() || fit_key != _farrow_key
+		|| freq_low < _farrow_low.front()
+		|| !(freq_high < _farrow_high.back()))
+	{
+		Fit_Farrow(fit_key, freq_low, freq_high);
+	}
+	if (_farrow_buffer.Size() != _total_taps_max)
+	{
+		_farrow_buffer.Configure(_total_taps_max, _total_taps_max);
+	}
+	else
+	{
+		_farrow_buffer.Clear();
+	}
+	_farrow_buffer.Set_Isa(_ring_buffer.Get_Isa());
+	long block_size = _farrow_buffer.Block_Size();
+	_farrow_block.resize((Farrow_Order + 2) * block_size);
+	double* positions = _farrow_block.data() + (Farrow_Order + 1) * block_size;
+	long sample = 0;
+	while (sample < filtered_signal_size)
+	{
+		long count = std::min(block_size, filtered_signal_size - sample);
+		if (sample < signal_size)
+		{
+			count = std::min(count, signal_size - sample);
+		}
+
+		// Run of samples whose cutoff lies in one segment, the tail keeps
+		// the cutoff of the last signal sample as the kernel path does
+		long segment = -1;
+		long run = 0;
+		while (run < count)
+		{
+			long rel_sample = std::max(0L,
+				std::min(sample + run, signal_size - 1) - load_samples);
+			double freq = Key_Value(Temporal_Kernel_Key(rel_sample, 0,
+				signal_size), 0);
+			long found = Farrow_Segment(freq);
+			if (segment >= 0 && found != segment) { break; }
+			segment = found;
+			double low = _farrow_low[segment];
+			double high = _farrow_high[segment];
+			positions[run] = (2.0 * freq - low - high) / (high - low);
+			run++;
+		}
+		double const* run_signal = nullptr;
+		if (sample < signal_size) { run_signal = signal + sample; }
+		Process_Farrow_Run(run_signal, run, segment, positions,
+			filtered_signal + sample);
+		sample += run;
+	}
+
+	return;
+}
+
+void firf_tmp_base::Load_Temporal_Imp_Resp(long curr_sample,
+	long load_samples, long signal_size)
+{
+	Load_Kernel(Temporal_Kernel_Key(curr_sample, load_samples,
+		signal_size));
+
+	return;
+}
+
+void firf_tmp_base::Synthesize_Exact_Imp_Resp(kernel_key const& key)
+{
+	// Prom: overrides synthesize key with wvt_lookup::direct, the response
+	// the Farrow fit approximates
+	Synthesize_Imp_Resp(key);
+
+	return;
+}
+
+void firf_tmp_base::Load_Heterodyne_Imp_Resp(kernel_key const&)
+{
+	// Prom: overrides load the prototype of key into _imp_resp_causal and
+	// _imp_resp_ring
+	throw config_error("Heterodyne mode needs a centre frequency");
+
+	return;
+}
+
+void firf_tmp_base::Discard_Imp_Resp()
+{
+	// Prom: the kernel cache, kernel bank and Farrow fit were synthesized
+	// from the previous wavetables, the bank has to be set again
+	firf_base::Discard_Imp_Resp();
+	Clear_Kernel_Cache();
+	Clear_Kernel_Bank();
+	_farrow_low.clear();
+	_farrow_high.clear();
+	_farrow_coeffs.clear();
+
+	return;
+}
+
+void firf_tmp_base::Load_Kernel(kernel_key const& key)
+{
+	// Prom: parameter_error when key has to be synthesized and is not
+	// Valid_Kernel_Key(key), such as a generator value out of range
+	// Prom: _imp_resp_causal and _imp_resp_ring hold the normalized
+	// response of key, or of the nearest grid point when the kernel bank
+	// covers key
+	if (Load_Bank_Imp_Resp(key)) { return; }
+	_kernel_bank_loaded = -1;
+	if (Load_Cached_Imp_Resp(key)) { return; }
+	if (!Valid_Kernel_Key(key))
+	{
+		throw parameter_error("Invalid filter parameter(s)");
+	}
+	Synthesize_Imp_Resp(key);
+	Store_Cached_Imp_Resp(key);
+
+	return;
+}
+
+bool firf_tmp_base::Load_Cached_Imp_Resp(kernel_key const& key)
+{
+	// Prom: true with _imp_resp_causal and _imp_resp_ring holding the
+	// kernel of key, false when it has to be synthesized
+	// Prom: no allocation once _imp_resp_* hold the largest kernel
+	if (_kernel_cache_loaded >= 0
+		&& _kernel_cache_keys[_kernel_cache_loaded] == key)
+	{
+		_kernel_cache_last_use[_kernel_cache_loaded] = ++_kernel_cache_clock;
+		_kernel_cache_hits++;
+		return true;
+	}
+	auto found = _kernel_cache_index.find(key);
+	if (found == _kernel_cache_index.end())
+	{
+		_kernel_cache_loaded = -1;
+		_kernel_cache_misses++;
+		return false;
+	}
+	long entry = found->second;
+	_imp_resp_causal.assign(_kernel_cache_causal[entry].begin(),
+		_kernel_cache_causal[entry].end());
+	_imp_resp_ring.assign(_kernel_cache_ring[entry].begin(),
+		_kernel_cache_ring[entry].end());
+	_kernel_cache_last_use[entry] = ++_kernel_cache_clock;
+	_kernel_cache_loaded = entry;
+	_kernel_cache_hits++;
+
+	return true;
+}
+
+void firf_tmp_base::Store_Cached_Imp_Resp(kernel_key const& key)
+{
+	// Req: _imp_resp_causal and _imp_resp_ring hold the normalized kernel
+	// of key, Load_Cached_Imp_Resp(key) returned false
+	// Prom: replaces the least recently used kernel when the cache is
+	// full, reusing its kernel memory
+	if (_kernel_cache_capacity == 0) { return; }
+	long entry = static_cast<long>(_kernel_cache_keys.size());
+	if (entry < _kernel_cache_capacity)
+	{
+		_kernel_cache_keys.push_back(key);
+		_kernel_cache_last_use.push_back(0);
+		_kernel_cache_causal.push_back(_imp_resp_causal);
+		_kernel_cache_ring.push_back(_imp_resp_ring);
+		_kernel_cache_index.emplace(key, entry);
+	}
+	else
+	{
+		entry = static_cast<long>(std::min_element(
+			_kernel_cache_last_use.begin(), _kernel_cache_last_use.end())
+			- _kernel_cache_last_use.begin());
+		_kernel_cache_index.erase(_kernel_cache_keys[entry]);
+		_kernel_cache_index.emplace(key, entry);
+		_kernel_cache_keys[entry] = key;
+		_kernel_cache_causal[entry].assign(_imp_resp_causal.begin(),
+			_imp_resp_causal.end());
+		_kernel_cache_ring[entry].assign(_imp_resp_ring.begin(),
+			_imp_resp_ring.end());
+	}
+	_kernel_cache_last_use[entry] = ++_kernel_cache_clock;
+	_kernel_cache_loaded = entry;
+
+	return;
+}
+
+bool firf_tmp_base::Load_Bank_Imp_Resp(kernel_key const& key)
+{
+	// Prom: true with _imp_resp_ring holding the bank response nearest to
+	// key and _imp_resp_causal its normalized causal taps, false when the
+	// bank does not cover key
+	// Prom: no allocation once _imp_resp_* hold the largest response
+	if (_kernel_bank_ring.empty()) { return false; }
+	long kernel = 0;
+	long stride = 1;
+	for (long axis = 0; axis < 3; axis++)
+	{
+		std::vector<double> const& points = _kernel_bank_axes[axis];
+		double value = Key_Value(key, axis);
+		if (value < points.front() || value > points.back()) { return false; }
+		long index = static_cast<long>(std::lower_bound(points.begin(),
+			points.end(), value) - points.begin());
+		if (index > 0 && value - points[index - 1] < points[index] - value)
+		{
+			index--;
+		}
+		kernel += index * stride;
+		stride *= static_cast<long>(points.size());
+	}
+	if (kernel == _kernel_bank_loaded) { return true; }
+	std::vector<double> const& ring = _kernel_bank_ring[kernel];
+	long causal = _kernel_bank_causal[kernel];
+	_imp_resp_ring.assign(ring.begin(), ring.end());
+	_imp_resp_causal.resize(causal);
+	for (long tap = 0; tap < causal; tap++)
+	{
+		_imp_resp_causal[tap] = ring[causal - 1 - tap];
+	}
+	_kernel_bank_loaded = kernel;
+	_kernel_cache_loaded = -1;
+
+	return true;
+}
+
+void firf_tmp_base::Refine_Bank_Axis(kernel_key key, long axis,
+	double high, std::vector<double>& points)
+{
+	// Req: key holds the low end of axis and of the other axes
+	// Prom: points sorted from the low to the high end of axis
+	double low = Key_Value(key, axis);
+	points.assign(1, low);
+	if (high == low) { return; }
+	Synthesize_Imp_Resp(key);
+	std::vector<double> ring_low = _imp_resp_ring;
+	long causal_low = static_cast<long>(_imp_resp_causal.size());
+	Set_Key_Value(key, axis, high);
+	Synthesize_Imp_Resp(key);
+	std::vector<double> ring_high = _imp_resp_ring;
+	long causal_high = static_cast<long>(_imp_resp_causal.size());
+	Refine_Bank_Interval(key, axis, low, ring_low, causal_low, high,
+		ring_high, causal_high, points);
+	points.push_back(high);
+
+	return;
+}
+
+void firf_tmp_base::Refine_Bank_Interval(kernel_key key, long axis,
+	double low, std::vector<double> const& ring_low, long causal_low,
+	double high, std::vector<double> const& ring_high, long causal_high,
+	std::vector<double>& points)
+{
+	// Prom: appends the grid points inside (low, high) in order
+	double middle = low + (high - low) / 2.0;
+	if (middle <= low || middle >= high) { return; }
+	Set_Key_Value(key, axis, middle);
+	Synthesize_Imp_Resp(key);
+	std::vector<double> ring_middle = _imp_resp_ring;
+	long causal_middle = static_cast<long>(_imp_resp_causal.size());
+	if (Kernel_Distance(ring_middle, causal_middle, ring_low, causal_low)
+		<= _error_max
+		&& Kernel_Distance(ring_middle, causal_middle, ring_high, causal_high)
+		<= _error_max)
+	{
+		return;
+	}
+	Refine_Bank_Interval(key, axis, low, ring_low, causal_low, middle,
+		ring_middle, causal_middle, points);
+	points.push_back(middle);
+	if (static_cast<long>(points.size()) > Kernel_Bank_Axis_Max)
+	{
+		throw config_error("Kernel bank grid exceeds Kernel_Bank_Axis_Max");
+	}
+	Refine_Bank_Interval(key, axis, middle, ring_middle, causal_middle, high,
+		ring_high, causal_high, points);
+
+	return;
+}
+
+bool firf_tmp_base::Refine_Bank_Cells(
+	std::vector<std::vector<double>>& axes,
+	std::map<kernel_key, long>& synthesized,
+	std::vector<std::vector<double>>& ring, std::vector<long>& causal)
+{
+	// Prom: true when a grid cell's centre response differed from the
+	// response of one of its corners by more than error_max and the axis
+	// the response changes most along from the low corner was split at the
+	// cell midpoint, see the top of file
+	std::vector<long> moving;
+	long cells = 1;
+	for (long axis = 0; axis < 3; axis++)
+	{
+		if (axes[axis].size() < 2) { continue; }
+		moving.push_back(axis);
+		cells *= static_cast<long>(axes[axis].size()) - 1;
+	}
+	if (moving.empty()) { return false; }
+	long corners = 1L << moving.size();
+	std::vector<std::vector<double>> splits(3);
+	for (long cell = 0; cell < cells; cell++)
+	{
+		kernel_key cell_low(axes[0][0], axes[1][0], axes[2][0]);
+		kernel_key cell_high = cell_low;
+		kernel_key centre = cell_low;
+		long rest = cell;
+		for (long axis : moving)
+		{
+			long intervals = static_cast<long>(axes[axis].size()) - 1;
+			long index = rest % intervals;
+			rest /= intervals;
+			double low = axes[axis][index];
+			double high = axes[axis][index + 1];
+			Set_Key_Value(cell_low, axis, low);
+			Set_Key_Value(cell_high, axis, high);
+			Set_Key_Value(centre, axis, low + (high - low) / 2.0);
+		}
+		long entry = Bank_Imp_Resp(centre, synthesized, ring, causal);
+		double distance = 0.0;
+		for (long corner = 0; corner < corners; corner++)
+		{
+			kernel_key corner_key = cell_low;
+			for (long bit = 0; bit < static_cast<long>(moving.size()); bit++)
+			{
+				if ((corner >> bit) & 1L)
+				{
+					Set_Key_Value(corner_key, moving[bit],
+						Key_Value(cell_high, moving[bit]));
+				}
+			}
+			long corner_entry = Bank_Imp_Resp(corner_key, synthesized, ring,
+				causal);
+			distance = std::max(distance, Kernel_Distance(ring[entry],
+				causal[entry], ring[corner_entry], causal[corner_entry]));
+		}
+		if (distance <= _error_max) { continue; }
+		long entry_low = Bank_Imp_Resp(cell_low, synthesized, ring, causal);
+		long split = moving.front();
+		double split_distance = -1.0;
+		for (long axis : moving)
+		{
+			kernel_key along = cell_low;
+			Set_Key_Value(along, axis, Key_Value(cell_high, axis));
+			long entry_along = Bank_Imp_Resp(along, synthesized, ring, causal);
+			double along_distance = Kernel_Distance(ring[entry_low],
+				causal[entry_low], ring[entry_along], causal[entry_along]);
+			if (along_distance > split_distance)
+			{
+				split = axis;
+				split_distance = along_distance;
+			}
+		}
+		double middle = Key_Value(centre, split);
+		if (middle > Key_Value(cell_low, split)
+			&& middle < Key_Value(cell_high, split))
+		{
+			splits[split].push_back(middle);
+		}
+	}
+	bool refined = false;
+	for (long axis = 0; axis < 3; axis++)
+	{
+		if (splits[axis].empty()) { continue; }
+		std::vector<double>& points = axes[axis];
+		points.insert(points.end(), splits[axis].begin(), splits[axis].end());
+		std::sort(points.begin(), points.end());
+		points.erase(std::unique(points.begin(), points.end()), points.end());
+		if (static_cast<long>(points.size()) > Kernel_Bank_Axis_Max)
+		{
+			throw config_error("Kernel bank grid exceeds Kernel_Bank_Axis_Max");
+		}
+		refined = true;
+	}
+
+	return refined;
+}
+
+long firf_tmp_base::Bank_Imp_Resp(kernel_key const& key,
+	std::map<kernel_key, long>& synthesized,
+	std::vector<std::vector<double>>& ring, std::vector<long>& causal)
+{
+	// Prom: entry of ring and causal holding the normalized response of
+	// key, synthesized on the first request
+	auto found = synthesized.find(key);
+	if (found != synthesized.end()) { return found->second; }
+	Synthesize_Imp_Resp(key);
+	long entry = static_cast<long>(ring.size());
+	ring.push_back(_imp_resp_ring);
+	causal.push_back(static_cast<long>(_imp_resp_causal.size()));
+	synthesized.emplace(key, entry);
+
+	return entry;
+}
+
+double firf_tmp_base::Kernel_Distance(std::vector<double> const& ring_a,
+	long causal_a, std::vector<double> const& ring_b, long causal_b) const
+{
+	// Prom: sum of absolute tap differences, the responses aligned on
+	// their zeroth causal tap and zero outside their taps
+	long size_a = static_cast<long>(ring_a.size());
+	long size_b = static_cast<long>(ring_b.size());
+	long first = -std::max(causal_a, causal_b) + 1;
+	long last = std::max(size_a - causal_a, size_b - causal_b);
+	double distance = 0.0;
+	for (long offset = first; offset <= last; offset++)
+	{
+		long tap_a = causal_a - 1 + offset;
+		long tap_b = causal_b - 1 + offset;
+		double a = (tap_a >= 0 && tap_a < size_a) ? ring_a[tap_a] : 0.0;
+		double b = (tap_b >= 0 && tap_b < size_b) ? ring_b[tap_b] : 0.0;
+		distance += std::abs(a - b);
+	}
+
+	return distance;
+}
+
+double firf_tmp_base::Key_Value(kernel_key const& key, long axis)
+{
+	if (axis == 0) { return std::get<0>(key); }
+	if (axis == 1) { return std::get<1>(key); }
+
+	return std::get<2>(key);
+}
+
+void firf_tmp_base::Set_Key_Value(kernel_key& key, long axis, double value)
+{
+	if (axis == 0) { std::get<0>(key) = value; }
+	else if (axis == 1) { std::get<1>(key) = value; }
+	else { std::get<2>(key) = value; }
+
+	return;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>	// std::min_element, std::max, std::lower_bound
+#include <cmath>		// std::abs
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "errors_custom.h"
+#include "firf_base.h"
+#include "wvt_cos.h"
+
+enum class control_mode { hold, interpolate, crossfade };
+
+class firf_tmp_base : public firf_base
+{
+public:
+	static constexpr long Kernel_Cache_Capacity_Default = 256;
+	static constexpr long Crossfade_Length_Default = 64;
+	static constexpr long Kernel_Bank_Axis_Max = 65536;
+	static constexpr long Farrow_Order = 3;
+	using kernel_key = std::tuple<double, double, double>;
+
+private:
+	long _kernel_cache_capacity;
+	long _kernel_cache_clock;
+	long _kernel_cache_loaded;
+	long _kernel_cache_hits;
+	long _kernel_cache_misses;
+	std::vector<kernel_key> _kernel_cache_keys;
+	std::vector<long> _kernel_cache_last_use;
+	std::vector<std::vector<double>> _kernel_cache_causal;
+	std::vector<std::vector<double>> _kernel_cache_ring;
+	std::map<kernel_key, long> _kernel_cache_index;
+	long _control_rate;
+	control_mode _control_mode;
+	long _control_span;
+	long _control_causal;
+	bool _control_folded;
+	std::vector<double> _control_ring_a;
+	std::vector<double> _control_ring_b;
+	long _control_causal_a;
+	long _control_causal_b;
+	std::vector<double> _control_base;
+	std::vector<double> _control_slope;
+	long _crossfade_length;
+	std::vector<double> _fade_ring;
+	std::vector<double> _fade_causal;
+	std::vector<double> _fade_output;
+	std::vector<std::vector<double>> _kernel_bank_axes;
+	std::vector<std::vector<double>> _kernel_bank_ring;
+	std::vector<long> _kernel_bank_causal;
+	long _kernel_bank_loaded;
+	ring_buffer _heterodyne_buffer;
+	std::vector<double> _heterodyne_block;
+	kernel_key _farrow_key;
+	std::vector<double> _farrow_low;
+	std::vector<double> _farrow_high;
+	std::vector<std::vector<double>> _farrow_coeffs;
+	long _farrow_cursor;
+	ring_buffer _farrow_buffer;
+	std::vector<double> _farrow_block;
+
+protected:
+	firf_tmp_base();
+
+public:
+	void Set_Kernel_Cache_Capacity(long kernels);
+	long Get_Kernel_Cache_Capacity() const;
+	long Get_Kernel_Cache_Hits() const;
+	long Get_Kernel_Cache_Misses() const;
+	double Get_Kernel_Cache_Hit_Rate() const;
+	void Clear_Kernel_Cache();
+	void Set_Control_Rate(long samples, control_mode mode);
+	long Get_Control_Rate() const;
+	control_mode Get_Control_Mode() const;
+	void Set_Crossfade_Length(long samples);
+	long Get_Crossfade_Length() const;
+	// signal in [-1.0, 1.0], the absolute range error_max is defined for
+	double Measure_Control_Error(std::vector<double> const& signal);
+	void Set_Kernel_Bank(kernel_key const& low, kernel_key const& high);
+	void Clear_Kernel_Bank();
+	long Get_Kernel_Bank_Kernels() const;
+	long Get_Kernel_Bank_Bytes() const;
+	long Get_Farrow_Segments() const;
+	long Get_Farrow_Bytes() const;
+
+protected:
+	std::vector<double> Filter_Temporal(std::vector<double> const& signal);
+	void Filter_Temporal(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size);
+	void Filter_Heterodyne(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size,
+		wvt_cos const& cos_wvt);
+	void Filter_Farrow(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size);
+	void Load_Temporal_Imp_Resp(long curr_sample, long load_samples,
+		long signal_size);
+	void Load_Kernel(kernel_key const& key);
+	virtual bool Valid_Parameters() const = 0;
+	virtual bool Valid_Kernel_Key(kernel_key const& key) const = 0;
+	virtual kernel_key Temporal_Kernel_Key(long curr_sample,
+		long load_samples, long signal_size) const = 0;
+	virtual void Synthesize_Imp_Resp(kernel_key const& key) = 0;
+	virtual void Synthesize_Exact_Imp_Resp(kernel_key const& key);
+	virtual void Load_Heterodyne_Imp_Resp(kernel_key const& key);
+	void Discard_Imp_Resp() override;
+
+private:
+	bool Load_Cached_Imp_Resp(kernel_key const& key);
+	void Store_Cached_Imp_Resp(kernel_key const& key);
+	bool Load_Bank_Imp_Resp(kernel_key const& key);
+	void Refine_Bank_Axis(kernel_key key, long axis, double high,
+		std::vector<double>& points);
+	void Refine_Bank_Interval(kernel_key key, long axis, double low,
+		std::vector<double> const& ring_low, long causal_low, double high,
+		std::vector<double> const& ring_high, long causal_high,
+		std::vector<double>& points);
+	bool Refine_Bank_Cells(std::vector<std::vector<double>>& axes,
+		std::map<kernel_key, long>& synthesized,
+		std::vector<std::vector<double>>& ring, std::vector<long>& causal);
+	long Bank_Imp_Resp(kernel_key const& key,
+		std::map<kernel_key, long>& synthesized,
+		std::vector<std::vector<double>>& ring, std::vector<long>& causal);
+	double Kernel_Distance(std::vector<double> const& ring_a, long causal_a,
+		std::vector<double> const& ring_b, long causal_b) const;
+	static double Key_Value(kernel_key const& key, long axis);
+	static void Set_Key_Value(kernel_key& key, long axis, double value);
+	void Load_Control_Imp_Resp(long curr_sample, long load_samples,
+		long signal_size);
+	void Start_Control_Interval(long curr_sample, long load_samples,
+		long signal_size);
+	void Interpolate_Control_Imp_Resp(double frac);
+	double Process_Temporal_Cycle();
+	void Filter_Spans(double const* signal, long signal_size,
+		double* filtered_signal, long filtered_signal_size);
+	double Heterodyne_Step(wvt_cos const& cos_wvt, long signal_size) const;
+	void Process_Span(double const* signal, long count,
+		double* filtered_signal, long fade_position, long fade_length);
+	void Fit_Farrow(kernel_key const& key, double freq_low, double freq_high);
+	void Fit_Farrow_Interval(kernel_key const& key, double low, double high,
+		std::vector<double> const& basis);
+	void Farrow_Taps(kernel_key key, double freq, std::vector<double>& taps);
+	double Farrow_Step(kernel_key key, double low, double high);
+	std::vector<double> Farrow_Basis() const;
+	long Farrow_Segment(double freq);
+	void Process_Farrow_Run(double const* signal, long count, long segment,
+		double const* positions, double* filtered_signal);
+};
@@ -28,11 +28,19 @@ bool imp_resp_base::Valid_Imp_Resp() const
 }
 
 std::tuple<double, double, double>
-    imp_resp_base::Error_Distribution(double error_max, double win_pow)
+    imp_resp_base::Error_Distribution(double error_max, double win_pow,
+    wvt_lookup lookup)
 {
     // Determines error distribution for minimum memory usage
+    //
+    // Linear lookup tables grow with c / sqrt(error), the total is least
+    // with the errors in proportion to c^(2 / 3), see Linear_Weight(...)
     double dist_sinc = 1.0;
     double dist_win_resp = win_pow / 4.0;
+    if (lookup == wvt_lookup::linear)
+    {
+        dist_win_resp = Linear_Weight(win_pow);
+    }
     double dist_total = dist_sinc + dist_win_resp;
     double error = error_max - (2 * DBL_EPSILON);
     double err_sinc = error * dist_sinc / dist_total;
@@ -41,6 +49,27 @@ std::tuple<double, double, double>
     return std::make_tuple(err_sinc, err_win, 0.0);
 }
 
+double imp_resp_base::Linear_Weight(double win_pow)
+{
+    // Prom: error share of the linear window table relative to the sinc
+    // table, (c_win / c_sinc)^(2 / 3) with c_sinc = pi / sqrt(3) and
+    // c_win = pi * sqrt(win_pow * max(win_pow - 1, 1)) / 4
+    if (win_pow == 0.0) { return 0.0; }
+    double curvature = win_pow * std::fmax(win_pow - 1.0, 1.0);
+
+    return std::cbrt(3.0 * curvature / 16.0);
+}
+
+void imp_resp_base::Reserve_Resp(std::vector<double>& imp_resp)
+{
+    // Prom: later responses up to _resp_samples_max do not allocate
+    imp_resp.reserve(_resp_samples_max);
+    _sinc_resp.reserve(_resp_samples_max);
+    _win_resp.reserve(_resp_samples_max);
+
+    return;
+}
+
 void imp_resp_base::Negate(std::vector<double>& resp)
 {
     for (auto& sample : resp) { sample *= -1.0; }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <cmath>	// std::log, std::abs
+#include <cmath>	// std::log, std::abs, std::cbrt, std::fmax
 #include <tuple>
 #include <vector>
 
@@ -14,6 +14,8 @@ protected:
 	wvt_win _win;
 	double _samplerate;
 	long _resp_samples_max;
+	std::vector<double> _sinc_resp;
+	std::vector<double> _win_resp;
 
 protected:
 	imp_resp_base();
@@ -25,7 +27,10 @@ public:
 
 protected:
 	virtual std::tuple<double, double, double>
-		Error_Distribution(double error_max, double win_pow);
+		Error_Distribution(double error_max, double win_pow,
+		wvt_lookup lookup);
+	double Linear_Weight(double win_pow);
+	virtual void Reserve_Resp(std::vector<double>& imp_resp);
 	void Negate(std::vector<double>& resp);
 	double Impulse(double freq_cutoff);
 };
\ No newline at end of file
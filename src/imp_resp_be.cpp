@@ -14,14 +14,25 @@ imp_resp_be::imp_resp_be(double samplerate,
 
 void imp_resp_be::Configure(double samplerate,
  double error_max, double win_pow, long resp_samples_max)
+{
+	Configure(samplerate, error_max, win_pow, resp_samples_max,
+		wvt_lookup::nearest);
+
+	return;
+}
+
+void imp_resp_be::Configure(double samplerate, double error_max,
+	double win_pow, long resp_samples_max, wvt_lookup lookup)
 {
 	double err_sinc(0.0), err_win(0.0), err_cos(0.0);
 	std::tie(err_sinc, err_win, err_cos) =
-		Error_Distribution(error_max, win_pow);
+		Error_Distribution(error_max, win_pow, lookup);
 	auto temp_resp = std::make_unique<imp_resp_be>();
-	temp_resp->_sinc.Configure(samplerate, err_sinc, resp_samples_max);
-	temp_resp->_win.Configure(samplerate, err_win, win_pow);
-	temp_resp->_cos.Configure(samplerate, err_cos, resp_samples_max);
+	temp_resp->_sinc.Configure(samplerate, err_sinc, resp_samples_max,
+		lookup);
+	temp_resp->_win.Configure(samplerate, err_win, win_pow, lookup);
+	temp_resp->_cos.Configure(samplerate, err_cos, resp_samples_max,
+		lookup);
 	temp_resp->_samplerate = samplerate;
 	temp_resp->_resp_samples_max = resp_samples_max;
 	*this = *(temp_resp.get());
@@ -31,25 +42,38 @@ void imp_resp_be::Configure(double samplerate,
 
 std::vector<double> imp_resp_be::Get_Causal_Imp_Resp(double freq_center,
 	double freq_bw, double atten_frac)
+{
+	std::vector<double> imp_resp;
+	Get_Causal_Imp_Resp(freq_center, freq_bw, atten_frac, imp_resp);
+
+	return imp_resp;
+}
+
+void imp_resp_be::Get_Causal_Imp_Resp(double freq_center, double freq_bw,
+	double atten_frac, std::vector<double>& imp_resp)
 {
 	// Req: Valid_Freq_Input(freq) && Valid_atten_Frac(atten_frac)
 	// Req: Valid_Imp_Resp()
-	std::vector<double> sinc(_sinc.Get_Causal_Sinc_Rev(freq_bw / 2.0,
-		_resp_samples_max));
-	std::vector<double> win(_win.Get_Causal_Window(sinc.size()));
-	std::vector<double> fshift(_cos.Get_Causal_Cos(freq_center, sinc.size()));
+	// Prom: no allocation after the first call
+	Reserve_Resp(imp_resp);
+	std::vector<double>& sinc = _sinc_resp;
+	_sinc.Get_Causal_Sinc_Rev(freq_bw / 2.0, _resp_samples_max, sinc);
+	std::vector<double>& win = _win_resp;
+	_win.Get_Causal_Window(sinc.size(), win);
+	std::vector<double>& fshift = _fshift_resp;
+	_cos.Get_Causal_Cos(freq_center, sinc.size(), fshift);
 	Negate(sinc);
 	sinc.at(0) += Impulse(freq_bw);
 	for (long sample = 1; sample < sinc.size(); sample++)
 	{
 		sinc.at(sample) *= atten_frac;
 	}
-	std::vector<double> imp_resp(sinc.size(), 0.0);
+	imp_resp.resize(sinc.size());
 	for (long sample = 0; sample < imp_resp.size(); sample++)
 	{
 		imp_resp.at(sample) = sinc.at(sample) *	win.at(sample)
 			* fshift.at(sample);
 	}
 
-	return imp_resp;
+	return;
 }
\ No newline at end of file
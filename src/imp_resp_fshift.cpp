@@ -10,6 +10,11 @@ bool imp_resp_fshift::Valid_Freq_Input(double freq) const
     return false;
 }
 
+wvt_cos const& imp_resp_fshift::Get_Cos_Wvt() const
+{
+	return _cos;
+}
+
 bool imp_resp_fshift::Valid_Imp_Resp() const
 {
     if (imp_resp_base::Valid_Imp_Resp()
@@ -21,12 +26,19 @@ bool imp_resp_fshift::Valid_Imp_Resp() const
 }
 
 std::tuple<double, double, double>
-    imp_resp_fshift::Error_Distribution(double error_max, double win_pow)
+    imp_resp_fshift::Error_Distribution(double error_max, double win_pow,
+    wvt_lookup lookup)
 {
     // Determines error distribution for minimum memory usage
     double dist_sinc = 1.0;
     double dist_win = win_pow / 4.0;
     double dist_cos = 1.0;
+    if (lookup == wvt_lookup::linear)
+    {
+        // (c_cos / c_sinc)^(2 / 3) with c_cos = pi, c_sinc = pi / sqrt(3)
+        dist_win = Linear_Weight(win_pow);
+        dist_cos = std::cbrt(3.0);
+    }
     double dist_total = dist_sinc + dist_win + dist_cos;
     double error = error_max - (2 * DBL_EPSILON);
     double err_sinc = error * dist_sinc / dist_total;
@@ -35,3 +47,11 @@ std::tuple<double, double, double>
 
     return std::make_tuple(err_sinc, err_win, err_cos);
 }
+
+void imp_resp_fshift::Reserve_Resp(std::vector<double>& imp_resp)
+{
+    imp_resp_base::Reserve_Resp(imp_resp);
+    _fshift_resp.reserve(_resp_samples_max);
+
+    return;
+}
\ No newline at end of file
@@ -13,13 +13,17 @@ class imp_resp_fshift : public imp_resp_base
 {
 protected:
 	wvt_cos _cos;
+	std::vector<double> _fshift_resp;
 
 public:
 	bool Valid_Freq_Input(double freq) const override;
 	bool Valid_Imp_Resp() const override;
+	wvt_cos const& Get_Cos_Wvt() const;
 
 protected:
 	virtual std::tuple<double, double, double>
-		Error_Distribution(double error_max, double win_pow) override;
+		Error_Distribution(double error_max, double win_pow,
+		wvt_lookup lookup) override;
+	void Reserve_Resp(std::vector<double>& imp_resp) override;
 };
 
@@ -14,13 +14,23 @@ imp_resp_lp::imp_resp_lp(double samplerate, double error_max,
 
 void imp_resp_lp::Configure(double samplerate, double error_max,
 	double win_pow, long resp_samples_max)
+{
+	Configure(samplerate, error_max, win_pow, resp_samples_max,
+		wvt_lookup::nearest);
+
+	return;
+}
+
+void imp_resp_lp::Configure(double samplerate, double error_max,
+	double win_pow, long resp_samples_max, wvt_lookup lookup)
 {
 	double err_sinc(0.0), err_win(0.0);
 	std::tie(err_sinc, err_win, std::ignore) =
-		Error_Distribution(error_max, win_pow);
+		Error_Distribution(error_max, win_pow, lookup);
 	auto temp_resp = std::make_unique<imp_resp_lp>();
-	temp_resp->_sinc.Configure(samplerate, err_sinc, resp_samples_max);
-	temp_resp->_win.Configure(samplerate, err_win, win_pow);
+	temp_resp->_sinc.Configure(samplerate, err_sinc, resp_samples_max,
+		lookup);
+	temp_resp->_win.Configure(samplerate, err_win, win_pow, lookup);
 	temp_resp->_samplerate = samplerate;
 	temp_resp->_resp_samples_max = resp_samples_max;
 	*this = *(temp_resp.get());
@@ -30,21 +40,33 @@ void imp_resp_lp::Configure(double samplerate, double error_max,
 
 std::vector<double> imp_resp_lp::Get_Causal_Imp_Resp(
 	double freq_cutoff, double atten_frac)
+{
+	std::vector<double> imp_resp;
+	Get_Causal_Imp_Resp(freq_cutoff, atten_frac, imp_resp);
+
+	return imp_resp;
+}
+
+void imp_resp_lp::Get_Causal_Imp_Resp(double freq_cutoff, double atten_frac,
+	std::vector<double>& imp_resp)
 {
 	// Req: Valid_Freq_Input(freq) && Valid_atten_Frac(atten_frac)
 	// Req: Valid_Imp_Resp()
-	std::vector<double> sinc(_sinc.Get_Causal_Sinc_Rev(freq_cutoff,
-		_resp_samples_max));
+	// Prom: no allocation after the first call
+	Reserve_Resp(imp_resp);
+	std::vector<double>& sinc = _sinc_resp;
+	_sinc.Get_Causal_Sinc_Rev(freq_cutoff, _resp_samples_max, sinc);
 	for (long sample = 1; sample < sinc.size(); sample++)
 	{
 		sinc.at(sample) *= atten_frac;
 	}
-	std::vector<double> win(_win.Get_Causal_Window(sinc.size()));
-	std::vector<double> imp_resp(sinc.size(), 0.0);
+	std::vector<double>& win = _win_resp;
+	_win.Get_Causal_Window(sinc.size(), win);
+	imp_resp.resize(sinc.size());
 	for (long sample = 0; sample < imp_resp.size(); sample++)
 	{
 		imp_resp.at(sample) = sinc.at(sample) *	win.at(sample);
 	}
 
-	return imp_resp;
+	return;
 }
@@ -16,7 +16,11 @@ public:
 public:
 	void Configure(double samplerate, double error_max, double win_pow,
 	long resp_samples_max);
+	void Configure(double samplerate, double error_max, double win_pow,
+		long resp_samples_max, wvt_lookup lookup);
 	std::vector<double> Get_Causal_Imp_Resp(double freq_cutoff,
 		double atten_frac);
+	void Get_Causal_Imp_Resp(double freq_cutoff, double atten_frac,
+		std::vector<double>& imp_resp);
 };
 
@@ -0,0 +1,750 @@
+#include "mac_kernel.h"
+
+#ifdef MAC_KERNEL_X86
+#include <immintrin.h>
+#endif
+#ifdef MAC_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+// Summation error of the vector kernels
+//
+// The scalar kernel adds the n products in order, which is the summation
+// accounted for in firf_base::Error_Imp_Resp(...). The vector kernels keep
+// L independent partial sums of about n / L products each and add the
+// partial sums pairwise at the end, so the worst case accumulation error
+// is (n / L + log2(L))e instead of ne. Each product is accumulated with
+// a fused multiply-add, which rounds once where a multiply and an add
+// round twice. The reordered result therefore stays inside the 2e per tap
+// budget of Error_Imp_Resp(...), but is not bitwise equal to the scalar
+// kernel.
+//
+// The folded kernels add the two samples that share a tap of a symmetric
+// response before multiplying. A pair of taps then costs one addition,
+// one multiplication and one accumulation instead of two multiplications
+// and two accumulations, so folding does not add rounding steps either.
+//
+// Tiled kernels
+//
+// Dot_Tile(...) computes consecutive outputs, whose windows are shifted
+// by one sample, in one pass over the taps. Each tap is broadcast once and
+// multiply-added into a tile of outputs kept in registers (16 for AVX2, 32
+// for AVX-512, 8 for NEON), so a tap load is shared by the whole tile and
+// each window load by a tile of outputs. The taps are processed in runs of
+// Tile_Taps (8 KiB of taps plus about 8 KiB of samples), which stay in a
+// 32 KiB L1 data cache while every tile of the block passes over them.
+//
+// Every output is one in order chain of fused multiply-adds over the taps,
+// whether it is computed in a vector lane or, for the outputs left over by
+// the tiles, by a scalar fused multiply-add. The result of an output
+// therefore does not depend on how the outputs are grouped into blocks and
+// tiles, and is the same for every vector ISA. The in order chain has the
+// ne summation error of the scalar kernel, see above. The scalar ISA adds
+// the products in order, fused only where the compiler contracts them.
+
+mac_kernel::mac_kernel() :
+	_isa(mac_isa::scalar), _dot(&mac_kernel::Dot_Scalar),
+	_dot_folded(&mac_kernel::Folded_Scalar),
+	_tile_plain(&mac_kernel::Tile_Scalar),
+	_tile_folded(&mac_kernel::Tile_Folded_Scalar)
+{
+	Configure(Best_Isa());
+
+	return;
+}
+
+mac_kernel::mac_kernel(mac_isa isa) :
+	_isa(mac_isa::scalar), _dot(&mac_kernel::Dot_Scalar),
+	_dot_folded(&mac_kernel::Folded_Scalar),
+	_tile_plain(&mac_kernel::Tile_Scalar),
+	_tile_folded(&mac_kernel::Tile_Folded_Scalar)
+{
+	Configure(isa);
+
+	return;
+}
+
+void mac_kernel::Configure(mac_isa isa)
+{
+	if (!Supported_Isa(isa))
+	{
+		throw config_error("Instruction set not supported by this processor");
+	}
+	switch (isa)
+	{
+#ifdef MAC_KERNEL_NEON
+	case mac_isa::neon:
+		_dot = &mac_kernel::Dot_Neon;
+		_dot_folded = &mac_kernel::Folded_Neon;
+		_tile_plain = &mac_kernel::Tile_Neon;
+		_tile_folded = &mac_kernel::Tile_Folded_Neon;
+		break;
+#endif
+#ifdef MAC_KERNEL_X86
+	case mac_isa::avx2:
+		_dot = &mac_kernel::Dot_Avx2;
+		_dot_folded = &mac_kernel::Folded_Avx2;
+		_tile_plain = &mac_kernel::Tile_Avx2;
+		_tile_folded = &mac_kernel::Tile_Folded_Avx2;
+		break;
+	case mac_isa::avx512:
+		_dot = &mac_kernel::Dot_Avx512;
+		_dot_folded = &mac_kernel::Folded_Avx512;
+		_tile_plain = &mac_kernel::Tile_Avx512;
+		_tile_folded = &mac_kernel::Tile_Folded_Avx512;
+		break;
+#endif
+	default:
+		_dot = &mac_kernel::Dot_Scalar;
+		_dot_folded = &mac_kernel::Folded_Scalar;
+		_tile_plain = &mac_kernel::Tile_Scalar;
+		_tile_folded = &mac_kernel::Tile_Folded_Scalar;
+		break;
+	}
+	_isa = isa;
+
+	return;
+}
+
+mac_isa mac_kernel::Get_Isa() const
+{
+	return _isa;
+}
+
+double mac_kernel::Dot(double const* a, double const* b, long size) const
+{
+	// Req: a and b hold size elements
+	return _dot(a, b, size);
+}
+
+double mac_kernel::Dot_Folded(double const* taps, double const* a,
+	double const* b, long size) const
+{
+	// Req: taps, a and b hold size elements
+	// Prom: sum of taps[n] * (a[n] + b[size - 1 - n])
+	return _dot_folded(taps, a, b, size);
+}
+
+void mac_kernel::Dot_Tile(double const* taps, long plain, long folded,
+	double const* window, long outputs, double* results) const
+{
+	// Req: taps hold plain taps, followed by 2 * folded + 1 taps mirrored
+	// around the zeroth tap when folded > 0
+	// Req: window holds outputs - 1 + the number of taps samples
+	// Prom: results[n] is the sum of the taps times the samples from
+	// window[n], the mirrored pairs of samples added before multiplying
+	std::fill(results, results + outputs, 0.0);
+	for (long first = 0; first < plain; first += Tile_Taps)
+	{
+		long size = std::min(Tile_Taps, plain - first);
+		_tile_plain(taps + first, window + first, size, outputs, results);
+	}
+	if (folded > 0)
+	{
+		long zeroth = plain + folded;
+		for (long first = 0; first < folded; first += Tile_Taps)
+		{
+			long size = std::min(Tile_Taps, folded - first);
+			_tile_folded(taps + plain + first, window + plain + first,
+				window + zeroth + folded - first, size, outputs, results);
+		}
+		_tile_plain(taps + zeroth, window + zeroth, 1, outputs, results);
+	}
+
+	return;
+}
+
+bool mac_kernel::Supported_Isa(mac_isa isa)
+{
+	// Prom: x86 support is determined at runtime with CPUID, so one binary
+	// can run on processors with and without AVX2 or AVX-512
+	switch (isa)
+	{
+	case mac_isa::scalar:
+		return true;
+#ifdef MAC_KERNEL_NEON
+	case mac_isa::neon:
+		return true;
+#endif
+#ifdef MAC_KERNEL_X86
+	case mac_isa::avx2:
+		return __builtin_cpu_supports("avx2")
+			&& __builtin_cpu_supports("fma");
+	case mac_isa::avx512:
+		return __builtin_cpu_supports("avx512f");
+#endif
+	default:
+		return false;
+	}
+}
+
+mac_isa mac_kernel::Best_Isa()
+{
+	if (Supported_Isa(mac_isa::avx512)) { return mac_isa::avx512; }
+	if (Supported_Isa(mac_isa::avx2)) { return mac_isa::avx2; }
+	if (Supported_Isa(mac_isa::neon)) { return mac_isa::neon; }
+	return mac_isa::scalar;
+}
+
+double mac_kernel::Dot_Scalar(double const* a, double const* b, long size)
+{
+	// Reference kernel, sums the products in order
+	double sum = 0.0;
+	for (long element = 0; element < size; element++)
+	{
+		sum += a[element] * b[element];
+	}
+
+	return sum;
+}
+
+double mac_kernel::Folded_Scalar(double const* taps, double const* a,
+	double const* b, long size)
+{
+	double sum = 0.0;
+	for (long element = 0; element < size; element++)
+	{
+		sum += taps[element] * (a[element] + b[size - 1 - element]);
+	}
+
+	return sum;
+}
+
+void mac_kernel::Tile_Scalar(double const* taps, double const* window,
+	long size, long outputs, double* results)
+{
+	// Prom: results[n] += taps[k] * window[n + k] in order of k
+	for (long output = 0; output < outputs; output++)
+	{
+		double sum = results[output];
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum += taps[tap] * window[output + tap];
+		}
+		results[output] = sum;
+	}
+
+	return;
+}
+
+void mac_kernel::Tile_Folded_Scalar(double const* taps, double const* a,
+	double const* b, long size, long outputs, double* results)
+{
+	// Prom: results[n] += taps[k] * (a[n + k] + b[n - k]) in order of k
+	for (long output = 0; output < outputs; output++)
+	{
+		double sum = results[output];
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum += taps[tap] * (a[output + tap] + b[output - tap]);
+		}
+		results[output] = sum;
+	}
+
+	return;
+}
+
+#ifdef MAC_KERNEL_NEON
+double mac_kernel::Dot_Neon(double const* a, double const* b, long size)
+{
+	float64x2_t sum_0 = vdupq_n_f64(0.0);
+	float64x2_t sum_1 = vdupq_n_f64(0.0);
+	float64x2_t sum_2 = vdupq_n_f64(0.0);
+	float64x2_t sum_3 = vdupq_n_f64(0.0);
+	long element = 0;
+	for (; element + 8 <= size; element += 8)
+	{
+		sum_0 = vfmaq_f64(sum_0, vld1q_f64(a + element),
+			vld1q_f64(b + element));
+		sum_1 = vfmaq_f64(sum_1, vld1q_f64(a + element + 2),
+			vld1q_f64(b + element + 2));
+		sum_2 = vfmaq_f64(sum_2, vld1q_f64(a + element + 4),
+			vld1q_f64(b + element + 4));
+		sum_3 = vfmaq_f64(sum_3, vld1q_f64(a + element + 6),
+			vld1q_f64(b + element + 6));
+	}
+	for (; element + 2 <= size; element += 2)
+	{
+		sum_0 = vfmaq_f64(sum_0, vld1q_f64(a + element),
+			vld1q_f64(b + element));
+	}
+	float64x2_t sum_v = vaddq_f64(vaddq_f64(sum_0, sum_1),
+		vaddq_f64(sum_2, sum_3));
+	double sum = vaddvq_f64(sum_v);
+	for (; element < size; element++)
+	{
+		sum += a[element] * b[element];
+	}
+
+	return sum;
+}
+
+double mac_kernel::Folded_Neon(double const* taps, double const* a,
+	double const* b, long size)
+{
+	// b is read backwards, vextq_f64 swaps the two lanes of each load
+	float64x2_t sum_0 = vdupq_n_f64(0.0);
+	float64x2_t sum_1 = vdupq_n_f64(0.0);
+	long element = 0;
+	for (; element + 4 <= size; element += 4)
+	{
+		float64x2_t b_0 = vld1q_f64(b + size - 2 - element);
+		float64x2_t b_1 = vld1q_f64(b + size - 4 - element);
+		sum_0 = vfmaq_f64(sum_0, vld1q_f64(taps + element),
+			vaddq_f64(vld1q_f64(a + element), vextq_f64(b_0, b_0, 1)));
+		sum_1 = vfmaq_f64(sum_1, vld1q_f64(taps + element + 2),
+			vaddq_f64(vld1q_f64(a + element + 2), vextq_f64(b_1, b_1, 1)));
+	}
+	double sum = vaddvq_f64(vaddq_f64(sum_0, sum_1));
+	for (; element < size; element++)
+	{
+		sum += taps[element] * (a[element] + b[size - 1 - element]);
+	}
+
+	return sum;
+}
+
+void mac_kernel::Tile_Neon(double const* taps, double const* window,
+	long size, long outputs, double* results)
+{
+	long output = 0;
+	for (; output + 8 <= outputs; output += 8)
+	{
+		float64x2_t sum_0 = vld1q_f64(results + output);
+		float64x2_t sum_1 = vld1q_f64(results + output + 2);
+		float64x2_t sum_2 = vld1q_f64(results + output + 4);
+		float64x2_t sum_3 = vld1q_f64(results + output + 6);
+		for (long tap = 0; tap < size; tap++)
+		{
+			float64x2_t tap_v = vld1q_dup_f64(taps + tap);
+			double const* w = window + output + tap;
+			sum_0 = vfmaq_f64(sum_0, tap_v, vld1q_f64(w));
+			sum_1 = vfmaq_f64(sum_1, tap_v, vld1q_f64(w + 2));
+			sum_2 = vfmaq_f64(sum_2, tap_v, vld1q_f64(w + 4));
+			sum_3 = vfmaq_f64(sum_3, tap_v, vld1q_f64(w + 6));
+		}
+		vst1q_f64(results + output, sum_0);
+		vst1q_f64(results + output + 2, sum_1);
+		vst1q_f64(results + output + 4, sum_2);
+		vst1q_f64(results + output + 6, sum_3);
+	}
+	for (; output < outputs; output++)
+	{
+		double sum = results[output];
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum = std::fma(taps[tap], window[output + tap], sum);
+		}
+		results[output] = sum;
+	}
+
+	return;
+}
+
+void mac_kernel::Tile_Folded_Neon(double const* taps, double const* a,
+	double const* b, long size, long outputs, double* results)
+{
+	long output = 0;
+	for (; output + 8 <= outputs; output += 8)
+	{
+		float64x2_t sum_0 = vld1q_f64(results + output);
+		float64x2_t sum_1 = vld1q_f64(results + output + 2);
+		float64x2_t sum_2 = vld1q_f64(results + output + 4);
+		float64x2_t sum_3 = vld1q_f64(results + output + 6);
+		for (long tap = 0; tap < size; tap++)
+		{
+			float64x2_t tap_v = vld1q_dup_f64(taps + tap);
+			double const* a_w = a + output + tap;
+			double const* b_w = b + output - tap;
+			sum_0 = vfmaq_f64(sum_0, tap_v,
+				vaddq_f64(vld1q_f64(a_w), vld1q_f64(b_w)));
+			sum_1 = vfmaq_f64(sum_1, tap_v,
+				vaddq_f64(vld1q_f64(a_w + 2), vld1q_f64(b_w + 2)));
+			sum_2 = vfmaq_f64(sum_2, tap_v,
+				vaddq_f64(vld1q_f64(a_w + 4), vld1q_f64(b_w + 4)));
+			sum_3 = vfmaq_f64(sum_3, tap_v,
+				vaddq_f64(vld1q_f64(a_w + 6), vld1q_f64(b_w + 6)));
+		}
+		vst1q_f64(results + output, sum_0);
+		vst1q_f64(results + output + 2, sum_1);
+		vst1q_f64(results + output + 4, sum_2);
+		vst1q_f64(results + output + 6, sum_3);
+	}
+	for (; output < outputs; output++)
+	{
+		double sum = results[output];
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum = std::fma(taps[tap], a[output + tap] + b[output - tap], sum);
+		}
+		results[output] = sum;
+	}
+
+	return;
+}
+#endif
+
+#ifdef MAC_KERNEL_X86
+__attribute__((target("avx2,fma")))
+double mac_kernel::Dot_Avx2(double const* a, double const* b, long size)
+{
+	__m256d sum_0 = _mm256_setzero_pd();
+	__m256d sum_1 = _mm256_setzero_pd();
+	__m256d sum_2 = _mm256_setzero_pd();
+	__m256d sum_3 = _mm256_setzero_pd();
+	long element = 0;
+	for (; element + 16 <= size; element += 16)
+	{
+		sum_0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + element),
+			_mm256_loadu_pd(b + element), sum_0);
+		sum_1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + element + 4),
+			_mm256_loadu_pd(b + element + 4), sum_1);
+		sum_2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + element + 8),
+			_mm256_loadu_pd(b + element + 8), sum_2);
+		sum_3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + element + 12),
+			_mm256_loadu_pd(b + element + 12), sum_3);
+	}
+	for (; element + 4 <= size; element += 4)
+	{
+		sum_0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + element),
+			_mm256_loadu_pd(b + element), sum_0);
+	}
+	__m256d sum_v = _mm256_add_pd(_mm256_add_pd(sum_0, sum_1),
+		_mm256_add_pd(sum_2, sum_3));
+	__m128d sum_h = _mm_add_pd(_mm256_castpd256_pd128(sum_v),
+		_mm256_extractf128_pd(sum_v, 1));
+	double sum = _mm_cvtsd_f64(_mm_add_sd(sum_h,
+		_mm_unpackhi_pd(sum_h, sum_h)));
+	for (; element < size; element++)
+	{
+		sum += a[element] * b[element];
+	}
+
+	return sum;
+}
+
+__attribute__((target("avx512f")))
+double mac_kernel::Dot_Avx512(double const* a, double const* b, long size)
+{
+	__m512d sum_0 = _mm512_setzero_pd();
+	__m512d sum_1 = _mm512_setzero_pd();
+	__m512d sum_2 = _mm512_setzero_pd();
+	__m512d sum_3 = _mm512_setzero_pd();
+	long element = 0;
+	for (; element + 32 <= size; element += 32)
+	{
+		sum_0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + element),
+			_mm512_loadu_pd(b + element), sum_0);
+		sum_1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + element + 8),
+			_mm512_loadu_pd(b + element + 8), sum_1);
+		sum_2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + element + 16),
+			_mm512_loadu_pd(b + element + 16), sum_2);
+		sum_3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + element + 24),
+			_mm512_loadu_pd(b + element + 24), sum_3);
+	}
+	for (; element + 8 <= size; element += 8)
+	{
+		sum_0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + element),
+			_mm512_loadu_pd(b + element), sum_0);
+	}
+	if (element < size)
+	{
+		// Masked loads read zeros past the end of the arrays
+		__mmask8 mask = static_cast<__mmask8>((1u << (size - element)) - 1u);
+		sum_1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, a + element),
+			_mm512_maskz_loadu_pd(mask, b + element), sum_1);
+	}
+	__m512d sum_v = _mm512_add_pd(_mm512_add_pd(sum_0, sum_1),
+		_mm512_add_pd(sum_2, sum_3));
+	// By hand, _mm512_reduce_add_pd passes undefined vectors to masked
+	// builtins that GCC reports as uninitialized
+	__m256d sum_q = _mm256_add_pd(
+		_mm512_maskz_extractf64x4_pd(0x0F, sum_v, 0),
+		_mm512_maskz_extractf64x4_pd(0x0F, sum_v, 1));
+	__m128d sum_h = _mm_add_pd(_mm256_castpd256_pd128(sum_q),
+		_mm256_extractf128_pd(sum_q, 1));
+
+	return _mm_cvtsd_f64(_mm_add_sd(sum_h, _mm_unpackhi_pd(sum_h, sum_h)));
+}
+
+__attribute__((target("avx2,fma")))
+double mac_kernel::Folded_Avx2(double const* taps, double const* a,
+	double const* b, long size)
+{
+	// b is read backwards, each load is reversed across its four lanes
+	__m256d sum_0 = _mm256_setzero_pd();
+	__m256d sum_1 = _mm256_setzero_pd();
+	long element = 0;
+	for (; element + 8 <= size; element += 8)
+	{
+		__m256d b_0 = _mm256_permute4x64_pd(
+			_mm256_loadu_pd(b + size - 4 - element), 0x1B);
+		__m256d b_1 = _mm256_permute4x64_pd(
+			_mm256_loadu_pd(b + size - 8 - element), 0x1B);
+		sum_0 = _mm256_fmadd_pd(_mm256_loadu_pd(taps + element),
+			_mm256_add_pd(_mm256_loadu_pd(a + element), b_0), sum_0);
+		sum_1 = _mm256_fmadd_pd(_mm256_loadu_pd(taps + element + 4),
+			_mm256_add_pd(_mm256_loadu_pd(a + element + 4), b_1), sum_1);
+	}
+	for (; element + 4 <= size; element += 4)
+	{
+		__m256d b_0 = _mm256_permute4x64_pd(
+			_mm256_loadu_pd(b + size - 4 - element), 0x1B);
+		sum_0 = _mm256_fmadd_pd(_mm256_loadu_pd(taps + element),
+			_mm256_add_pd(_mm256_loadu_pd(a + element), b_0), sum_0);
+	}
+	__m256d sum_v = _mm256_add_pd(sum_0, sum_1);
+	__m128d sum_h = _mm_add_pd(_mm256_castpd256_pd128(sum_v),
+		_mm256_extractf128_pd(sum_v, 1));
+	double sum = _mm_cvtsd_f64(_mm_add_sd(sum_h,
+		_mm_unpackhi_pd(sum_h, sum_h)));
+	for (; element < size; element++)
+	{
+		sum += taps[element] * (a[element] + b[size - 1 - element]);
+	}
+
+	return sum;
+}
+
+__attribute__((target("avx512f")))
+double mac_kernel::Folded_Avx512(double const* taps, double const* a,
+	double const* b, long size)
+{
+	// b is read backwards, each load is reversed across its eight lanes,
+	// the zero masked permute keeps undefined vectors out of the builtin
+	__m512i reverse = _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+	__m512d sum_0 = _mm512_setzero_pd();
+	__m512d sum_1 = _mm512_setzero_pd();
+	long element = 0;
+	for (; element + 16 <= size; element += 16)
+	{
+		__m512d b_0 = _mm512_maskz_permutexvar_pd(0xFF, reverse,
+			_mm512_loadu_pd(b + size - 8 - element));
+		__m512d b_1 = _mm512_maskz_permutexvar_pd(0xFF, reverse,
+			_mm512_loadu_pd(b + size - 16 - element));
+		sum_0 = _mm512_fmadd_pd(_mm512_loadu_pd(taps + element),
+			_mm512_add_pd(_mm512_loadu_pd(a + element), b_0), sum_0);
+		sum_1 = _mm512_fmadd_pd(_mm512_loadu_pd(taps + element + 8),
+			_mm512_add_pd(_mm512_loadu_pd(a + element + 8), b_1), sum_1);
+	}
+	for (; element + 8 <= size; element += 8)
+	{
+		__m512d b_0 = _mm512_maskz_permutexvar_pd(0xFF, reverse,
+			_mm512_loadu_pd(b + size - 8 - element));
+		sum_0 = _mm512_fmadd_pd(_mm512_loadu_pd(taps + element),
+			_mm512_add_pd(_mm512_loadu_pd(a + element), b_0), sum_0);
+	}
+	__m512d sum_v = _mm512_add_pd(sum_0, sum_1);
+	// By hand, _mm512_reduce_add_pd passes undefined vectors to masked
+	// builtins that GCC reports as uninitialized
+	__m256d sum_q = _mm256_add_pd(
+		_mm512_maskz_extractf64x4_pd(0x0F, sum_v, 0),
+		_mm512_maskz_extractf64x4_pd(0x0F, sum_v, 1));
+	__m128d sum_h = _mm_add_pd(_mm256_castpd256_pd128(sum_q),
+		_mm256_extractf128_pd(sum_q, 1));
+	double sum = _mm_cvtsd_f64(_mm_add_sd(sum_h,
+		_mm_unpackhi_pd(sum_h, sum_h)));
+	for (; element < size; element++)
+	{
+		sum += taps[element] * (a[element] + b[size - 1 - element]);
+	}
+
+	return sum;
+}
+
+__attribute__((target("avx2,fma")))
+void mac_kernel::Tile_Avx2(double const* taps, double const* window,
+	long size, long outputs, double* results)
+{
+	long output = 0;
+	for (; output + 16 <= outputs; output += 16)
+	{
+		__m256d sum_0 = _mm256_loadu_pd(results + output);
+		__m256d sum_1 = _mm256_loadu_pd(results + output + 4);
+		__m256d sum_2 = _mm256_loadu_pd(results + output + 8);
+		__m256d sum_3 = _mm256_loadu_pd(results + output + 12);
+		for (long tap = 0; tap < size; tap++)
+		{
+			__m256d tap_v = _mm256_broadcast_sd(taps + tap);
+			double const* w = window + output + tap;
+			sum_0 = _mm256_fmadd_pd(tap_v, _mm256_loadu_pd(w), sum_0);
+			sum_1 = _mm256_fmadd_pd(tap_v, _mm256_loadu_pd(w + 4), sum_1);
+			sum_2 = _mm256_fmadd_pd(tap_v, _mm256_loadu_pd(w + 8), sum_2);
+			sum_3 = _mm256_fmadd_pd(tap_v, _mm256_loadu_pd(w + 12), sum_3);
+		}
+		_mm256_storeu_pd(results + output, sum_0);
+		_mm256_storeu_pd(results + output + 4, sum_1);
+		_mm256_storeu_pd(results + output + 8, sum_2);
+		_mm256_storeu_pd(results + output + 12, sum_3);
+	}
+	for (; output + 4 <= outputs; output += 4)
+	{
+		__m256d sum_0 = _mm256_loadu_pd(results + output);
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum_0 = _mm256_fmadd_pd(_mm256_broadcast_sd(taps + tap),
+				_mm256_loadu_pd(window + output + tap), sum_0);
+		}
+		_mm256_storeu_pd(results + output, sum_0);
+	}
+	for (; output < outputs; output++)
+	{
+		__m128d sum = _mm_load_sd(results + output);
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum = _mm_fmadd_sd(_mm_load_sd(taps + tap),
+				_mm_load_sd(window + output + tap), sum);
+		}
+		_mm_store_sd(results + output, sum);
+	}
+
+	return;
+}
+
+__attribute__((target("avx2,fma")))
+void mac_kernel::Tile_Folded_Avx2(double const* taps, double const* a,
+	double const* b, long size, long outputs, double* results)
+{
+	long output = 0;
+	for (; output + 16 <= outputs; output += 16)
+	{
+		__m256d sum_0 = _mm256_loadu_pd(results + output);
+		__m256d sum_1 = _mm256_loadu_pd(results + output + 4);
+		__m256d sum_2 = _mm256_loadu_pd(results + output + 8);
+		__m256d sum_3 = _mm256_loadu_pd(results + output + 12);
+		for (long tap = 0; tap < size; tap++)
+		{
+			__m256d tap_v = _mm256_broadcast_sd(taps + tap);
+			double const* a_w = a + output + tap;
+			double const* b_w = b + output - tap;
+			sum_0 = _mm256_fmadd_pd(tap_v, _mm256_add_pd(
+				_mm256_loadu_pd(a_w), _mm256_loadu_pd(b_w)), sum_0);
+			sum_1 = _mm256_fmadd_pd(tap_v, _mm256_add_pd(
+				_mm256_loadu_pd(a_w + 4), _mm256_loadu_pd(b_w + 4)), sum_1);
+			sum_2 = _mm256_fmadd_pd(tap_v, _mm256_add_pd(
+				_mm256_loadu_pd(a_w + 8), _mm256_loadu_pd(b_w + 8)), sum_2);
+			sum_3 = _mm256_fmadd_pd(tap_v, _mm256_add_pd(
+				_mm256_loadu_pd(a_w + 12), _mm256_loadu_pd(b_w + 12)), sum_3);
+		}
+		_mm256_storeu_pd(results + output, sum_0);
+		_mm256_storeu_pd(results + output + 4, sum_1);
+		_mm256_storeu_pd(results + output + 8, sum_2);
+		_mm256_storeu_pd(results + output + 12, sum_3);
+	}
+	for (; output + 4 <= outputs; output += 4)
+	{
+		__m256d sum_0 = _mm256_loadu_pd(results + output);
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum_0 = _mm256_fmadd_pd(_mm256_broadcast_sd(taps + tap),
+				_mm256_add_pd(_mm256_loadu_pd(a + output + tap),
+				_mm256_loadu_pd(b + output - tap)), sum_0);
+		}
+		_mm256_storeu_pd(results + output, sum_0);
+	}
+	for (; output < outputs; output++)
+	{
+		__m128d sum = _mm_load_sd(results + output);
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum = _mm_fmadd_sd(_mm_load_sd(taps + tap),
+				_mm_add_sd(_mm_load_sd(a + output + tap),
+				_mm_load_sd(b + output - tap)), sum);
+		}
+		_mm_store_sd(results + output, sum);
+	}
+
+	return;
+}
+
+__attribute__((target("avx512f")))
+void mac_kernel::Tile_Avx512(double const* taps, double const* window,
+	long size, long outputs, double* results)
+{
+	long output = 0;
+	for (; output + 32 <= outputs; output += 32)
+	{
+		__m512d sum_0 = _mm512_loadu_pd(results + output);
+		__m512d sum_1 = _mm512_loadu_pd(results + output + 8);
+		__m512d sum_2 = _mm512_loadu_pd(results + output + 16);
+		__m512d sum_3 = _mm512_loadu_pd(results + output + 24);
+		for (long tap = 0; tap < size; tap++)
+		{
+			__m512d tap_v = _mm512_set1_pd(taps[tap]);
+			double const* w = window + output + tap;
+			sum_0 = _mm512_fmadd_pd(tap_v, _mm512_loadu_pd(w), sum_0);
+			sum_1 = _mm512_fmadd_pd(tap_v, _mm512_loadu_pd(w + 8), sum_1);
+			sum_2 = _mm512_fmadd_pd(tap_v, _mm512_loadu_pd(w + 16), sum_2);
+			sum_3 = _mm512_fmadd_pd(tap_v, _mm512_loadu_pd(w + 24), sum_3);
+		}
+		_mm512_storeu_pd(results + output, sum_0);
+		_mm512_storeu_pd(results + output + 8, sum_1);
+		_mm512_storeu_pd(results + output + 16, sum_2);
+		_mm512_storeu_pd(results + output + 24, sum_3);
+	}
+	while (output < outputs)
+	{
+		// Masked lanes neither load past the window nor store
+		long lanes = std::min(outputs - output, 8L);
+		__mmask8 mask = static_cast<__mmask8>((1u << lanes) - 1u);
+		__m512d sum_0 = _mm512_maskz_loadu_pd(mask, results + output);
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum_0 = _mm512_fmadd_pd(_mm512_set1_pd(taps[tap]),
+				_mm512_maskz_loadu_pd(mask, window + output + tap), sum_0);
+		}
+		_mm512_mask_storeu_pd(results + output, mask, sum_0);
+		output += lanes;
+	}
+
+	return;
+}
+
+__attribute__((target("avx512f")))
+void mac_kernel::Tile_Folded_Avx512(double const* taps, double const* a,
+	double const* b, long size, long outputs, double* results)
+{
+	long output = 0;
+	for (; output + 32 <= outputs; output += 32)
+	{
+		__m512d sum_0 = _mm512_loadu_pd(results + output);
+		__m512d sum_1 = _mm512_loadu_pd(results + output + 8);
+		__m512d sum_2 = _mm512_loadu_pd(results + output + 16);
+		__m512d sum_3 = _mm512_loadu_pd(results + output + 24);
+		for (long tap = 0; tap < size; tap++)
+		{
+			__m512d tap_v = _mm512_set1_pd(taps[tap]);
+			double const* a_w = a + output + tap;
+			double const* b_w = b + output - tap;
+			sum_0 = _mm512_fmadd_pd(tap_v, _mm512_add_pd(
+				_mm512_loadu_pd(a_w), _mm512_loadu_pd(b_w)), sum_0);
+			sum_1 = _mm512_fmadd_pd(tap_v, _mm512_add_pd(
+				_mm512_loadu_pd(a_w + 8), _mm512_loadu_pd(b_w + 8)), sum_1);
+			sum_2 = _mm512_fmadd_pd(tap_v, _mm512_add_pd(
+				_mm512_loadu_pd(a_w + 16), _mm512_loadu_pd(b_w + 16)), sum_2);
+			sum_3 = _mm512_fmadd_pd(tap_v, _mm512_add_pd(
+				_mm512_loadu_pd(a_w + 24), _mm512_loadu_pd(b_w + 24)), sum_3);
+		}
+		_mm512_storeu_pd(results + output, sum_0);
+		_mm512_storeu_pd(results + output + 8, sum_1);
+		_mm512_storeu_pd(results + output + 16, sum_2);
+		_mm512_storeu_pd(results + output + 24, sum_3);
+	}
+	while (output < outputs)
+	{
+		long lanes = std::min(outputs - output, 8L);
+		__mmask8 mask = static_cast<__mmask8>((1u << lanes) - 1u);
+		__m512d sum_0 = _mm512_maskz_loadu_pd(mask, results + output);
+		for (long tap = 0; tap < size; tap++)
+		{
+			sum_0 = _mm512_fmadd_pd(_mm512_set1_pd(taps[tap]), _mm512_add_pd(
+				_mm512_maskz_loadu_pd(mask, a + output + tap),
+				_mm512_maskz_loadu_pd(mask, b + output - tap)), sum_0);
+		}
+		_mm512_mask_storeu_pd(results + output, mask, sum_0);
+		output += lanes;
+	}
+
+	return;
+}
+#endif
\ No newline at end of file
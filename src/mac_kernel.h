@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>	// std::fill, std::min
+#include <cmath>		// std::fma
+
+#include "errors_custom.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MAC_KERNEL_X86
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define MAC_KERNEL_NEON
+#endif
+
+enum class mac_isa { scalar, neon, avx2, avx512 };
+
+class mac_kernel
+{
+public:
+	static constexpr long Tile_Taps = 1024;
+
+private:
+	mac_isa _isa;
+	double (*_dot)(double const* a, double const* b, long size);
+	double (*_dot_folded)(double const* taps, double const* a,
+		double const* b, long size);
+	void (*_tile_plain)(double const* taps, double const* window, long size,
+		long outputs, double* results);
+	void (*_tile_folded)(double const* taps, double const* a,
+		double const* b, long size, long outputs, double* results);
+
+public:
+	mac_kernel();
+	mac_kernel(mac_isa isa);
+
+public:
+	void Configure(mac_isa isa);
+	mac_isa Get_Isa() const;
+	double Dot(double const* a, double const* b, long size) const;
+	double Dot_Folded(double const* taps, double const* a, double const* b,
+		long size) const;
+	void Dot_Tile(double const* taps, long plain, long folded,
+		double const* window, long outputs, double* results) const;
+	static bool Supported_Isa(mac_isa isa);
+	static mac_isa Best_Isa();
+
+private:
+	static double Dot_Scalar(double const* a, double const* b, long size);
+	static double Folded_Scalar(double const* taps, double const* a,
+		double const* b, long size);
+	static void Tile_Scalar(double const* taps, double const* window,
+		long size, long outputs, double* results);
+	static void Tile_Folded_Scalar(double const* taps, double const* a,
+		double const* b, long size, long outputs, double* results);
+#ifdef MAC_KERNEL_NEON
+	static double Dot_Neon(double const* a, double const* b, long size);
+	static double Folded_Neon(double const* taps, double const* a,
+		double const* b, long size);
+	static void Tile_Neon(double const* taps, double const* window,
+		long size, long outputs, double* results);
+	static void Tile_Folded_Neon(double const* taps, double const* a,
+		double const* b, long size, long outputs, double* results);
+#endif
+#ifdef MAC_KERNEL_X86
+	static double Dot_Avx2(double const* a, double const* b, long size);
+	static double Dot_Avx512(double const* a, double const* b, long size);
+	static double Folded_Avx2(double const* taps, double const* a,
+		double const* b, long size);
+	static double Folded_Avx512(double const* taps, double const* a,
+		double const* b, long size);
+	static void Tile_Avx2(double const* taps, double const* window,
+		long size, long outputs, double* results);
+	static void Tile_Folded_Avx2(double const* taps, double const* a,
+		double const* b, long size, long outputs, double* results);
+	static void Tile_Avx512(double const* taps, double const* window,
+		long size, long outputs, double* results);
+	static void Tile_Folded_Avx512(double const* taps, double const* a,
+		double const* b, long size, long outputs, double* results);
+#endif
+};
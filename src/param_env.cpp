@@ -0,0 +1,179 @@
+#include "param_env.h"
+
+// Parameter envelopes
+//
+// A temporal filter asks for the value of each parameter at the input
+// sample a response is loaded for. env_shape::stretch maps the samples of
+// the signal onto the elements of a caller owned vector, as the vector
+// parameters always did. env_shape::step and env_shape::linear hold or
+// interpolate between (sample, value) breakpoints, given in input samples
+// from the start of the signal and held constant before the first and
+// after the last breakpoint. env_shape::generator calls back for every
+// value. Breakpoint envelopes take memory for their breakpoints only,
+// however long the signal.
+//
+// Filters ask for samples in increasing order, so Value(...) keeps the
+// segment of the last lookup and steps forward from it, O(1) amortized,
+// and only searches the breakpoints when a sample lies behind it.
+
+param_env::param_env() :
+	_shape(env_shape::stretch), _stretch(nullptr), _cursor(0) {}
+
+param_env::param_env(std::vector<double> const* values) : param_env()
+{
+	// Req: values outlives the filter using it, as the vector parameters
+	_stretch = values;
+
+	return;
+}
+
+param_env::param_env(std::vector<breakpoint> const& breakpoints,
+	env_shape shape) : param_env()
+{
+	// Req: breakpoints not empty, sample times strictly increasing
+	if (breakpoints.empty()
+		|| (shape != env_shape::step && shape != env_shape::linear))
+	{
+		throw parameter_error("Invalid parameter envelope");
+	}
+	for (std::size_t point = 1; point < breakpoints.size(); point++)
+	{
+		if (breakpoints[point].first <= breakpoints[point - 1].first)
+		{
+			throw parameter_error("Invalid parameter envelope");
+		}
+	}
+	_shape = shape;
+	_times.reserve(breakpoints.size());
+	_values.reserve(breakpoints.size());
+	for (auto const& point : breakpoints)
+	{
+		_times.push_back(point.first);
+		_values.push_back(point.second);
+	}
+
+	return;
+}
+
+param_env::param_env(std::function<double(long)> generator) : param_env()
+{
+	if (!generator)
+	{
+		throw parameter_error("Invalid parameter envelope");
+	}
+	_shape = env_shape::generator;
+	_generator = std::move(generator);
+
+	return;
+}
+
+double param_env::Value(long sample, long signal_size) const
+{
+	// Req: Valid_Param_Env(), sample [0, signal_size)
+	// Prom: no allocation
+	if (_shape == env_shape::stretch)
+	{
+		return Stretch_Value(sample, signal_size);
+	}
+	if (_shape == env_shape::generator) { return _generator(sample); }
+	long segment = Find_Segment(sample);
+	if (segment < 0) { return _values.front(); }
+	long last = static_cast<long>(_times.size()) - 1;
+	if (_shape == env_shape::step || segment == last)
+	{
+		return _values[segment];
+	}
+	double span = static_cast<double>(_times[segment + 1] - _times[segment]);
+	double frac = static_cast<double>(sample - _times[segment]) / span;
+
+	return _values[segment] + frac * (_values[segment + 1] - _values[segment]);
+}
+
+bool param_env::Valid_Param_Env() const
+{
+	if (_shape == env_shape::stretch)
+	{
+		if (_stretch != nullptr && !_stretch->empty()
+			&& _stretch->size() <= pow(FLT_RADIX, DBL_MANT_DIG)
+			&& _stretch->size() <= LONG_MAX)
+		{
+			return true;
+		}
+		return false;
+	}
+	if (_shape == env_shape::generator)
+	{
+		if (_generator) { return true; }
+		return false;
+	}
+	if (!_times.empty()) { return true; }
+	return false;
+}
+
+bool param_env::Valid_Values(std::function<bool(double)> const& valid) const
+{
+	// Prom: whether valid(...) holds for every vector element or
+	// breakpoint value, which bounds every value of a step or linear
+	// envelope; generator values are only known while filtering
+	if (!Valid_Param_Env()) { return false; }
+	std::vector<double> const* values = &_values;
+	if (_shape == env_shape::stretch) { values = _stretch; }
+	for (double value : *values)
+	{
+		if (!valid(value)) { return false; }
+	}
+
+	return true;
+}
+
+bool param_env::Constant() const
+{
+	// Prom: true when every sample gets the same value
+	if (!Valid_Param_Env() || _shape == env_shape::generator) { return false; }
+	std::vector<double> const* values = &_values;
+	if (_shape == env_shape::stretch) { values = _stretch; }
+	if (std::adjacent_find(values->begin(), values->end(),
+		std::not_equal_to<double>()) == values->end())
+	{
+		return true;
+	}
+	return false;
+}
+
+env_shape param_env::Get_Shape() const
+{
+	return _shape;
+}
+
+long param_env::Get_Breakpoints() const
+{
+	return static_cast<long>(_times.size());
+}
+
+double param_env::Stretch_Value(long sample, long signal_size) const
+{
+	// Prom: element of the vector stretched over signal_size samples
+	double temporal_frac = static_cast<double>(sample)
+		/ static_cast<double>(signal_size);
+	double values_size_fp = static_cast<double>(_stretch->size());
+	long index = static_cast<long>(temporal_frac * values_size_fp);
+
+	return _stretch->at(index);
+}
+
+long param_env::Find_Segment(long sample) const
+{
+	// Prom: last breakpoint at or before sample, -1 before the first
+	long last = static_cast<long>(_times.size()) - 1;
+	if (sample < _times[_cursor])
+	{
+		auto after = std::upper_bound(_times.begin(), _times.end(), sample);
+		_cursor = std::max(0L,
+			static_cast<long>(after - _times.begin()) - 1);
+		if (sample < _times[_cursor]) { return -1; }
+		return _cursor;
+	}
+	while (_cursor < last && _times[_cursor + 1] <= sample) { _cursor++; }
+
+	return _cursor;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>	// std::adjacent_find, std::upper_bound
+#include <cfloat>
+#include <climits>
+#include <cmath>		// std::pow
+#include <functional>	// std::function, std::not_equal_to
+#include <utility>		// std::pair
+#include <vector>
+
+#include "errors_custom.h"
+
+enum class env_shape { stretch, step, linear, generator };
+
+class param_env
+{
+public:
+	using breakpoint = std::pair<long, double>;
+
+private:
+	env_shape _shape;
+	std::vector<double> const* _stretch;
+	std::vector<long> _times;
+	std::vector<double> _values;
+	std::function<double(long)> _generator;
+	mutable long _cursor;
+
+public:
+	param_env();
+	param_env(std::vector<double> const* values);
+	param_env(std::vector<breakpoint> const& breakpoints, env_shape shape);
+	param_env(std::function<double(long)> generator);
+
+public:
+	double Value(long sample, long signal_size) const;
+	bool Valid_Param_Env() const;
+	bool Valid_Values(std::function<bool(double)> const& valid) const;
+	bool Constant() const;
+	env_shape Get_Shape() const;
+	long Get_Breakpoints() const;
+
+private:
+	double Stretch_Value(long sample, long signal_size) const;
+	long Find_Segment(long sample) const;
+};
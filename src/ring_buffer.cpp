@@ -1,8 +1,20 @@
 #include "ring_buffer.h"
 
+// Layout
+//
+// The buffer holds the last _capacity samples in insertion order, oldest
+// first. Every sample is written twice, at its position and _capacity
+// elements later, so any run of up to _capacity consecutive samples is
+// one contiguous span of _ring_buffer. The taps are therefore applied with
+// a single linear dot product, and taps are given in the same order as the
+// samples (the tap for the oldest sample first).
+//
+// _capacity is _total_elements + _block_elements - 1, which keeps the tap
+// window of every sample of the most recent Insert_Block(...) available.
+
 ring_buffer::ring_buffer() :
-	_curr_start(0), _curr_zeroth(0), _curr_end(0), _index_max(0),
-	_total_elements(0), _non_causal_elements(0) {}
+	_curr_end(0), _capacity(0), _block_elements(0), _total_elements(0),
+	_non_causal_elements(0) {}
 
 ring_buffer::ring_buffer(long total_elements, long causal_elements) :
 	ring_buffer()
@@ -12,18 +24,38 @@ ring_buffer::ring_buffer(long total_elements, long causal_elements) :
 	return;
 }
 
+ring_buffer::ring_buffer(long total_elements, long causal_elements,
+	long block_elements) :
+	ring_buffer()
+{
+	Configure(total_elements, causal_elements, block_elements);
+
+	return;
+}
+
 void ring_buffer::Configure(long total_elements, long causal_elements)
+{
+	Configure(total_elements, causal_elements, Block_Elements_Default);
+
+	return;
+}
+
+void ring_buffer::Configure(long total_elements, long causal_elements,
+	long block_elements)
 {
 	if (!Valid_Total_Elements(total_elements)
-		|| total_elements < causal_elements)
+		|| total_elements < causal_elements
+		|| block_elements < 1
+		|| block_elements > (LONG_MAX / 2) - total_elements
+		|| !Valid_Total_Elements(2 * (total_elements + block_elements - 1)))
 	{
 		throw config_error("Invalid ring_buffer configuration size");
 	}
-	_ring_buffer = std::vector<double>(total_elements, 0.0);
-	_curr_start = 0;
-	_curr_zeroth = total_elements - causal_elements;
-	_curr_end = total_elements - 1;
-	_index_max = total_elements - 1;
+	long capacity = total_elements + block_elements - 1;
+	_ring_buffer = std::vector<double>(2 * capacity, 0.0);
+	_curr_end = capacity - 1;
+	_capacity = capacity;
+	_block_elements = block_elements;
 	_total_elements = total_elements;
 	_non_causal_elements = total_elements - causal_elements;
 
@@ -32,28 +64,84 @@ void ring_buffer::Configure(long total_elements, long causal_elements)
 
 void ring_buffer::Insert(double value)
 {
-	Decrement_Curr_Indices();
-	_ring_buffer.at(_curr_start) = value;
+	_curr_end++;
+	if (_curr_end == _capacity) { _curr_end = 0; }
+	_ring_buffer[_curr_end] = value;
+	_ring_buffer[_curr_end + _capacity] = value;
+
+	return;
+}
+
+void ring_buffer::Insert_Block(double const* data, long size)
+{
+	// Req: size [0, Block_Size()]
+	// Prom: block is copied to both halves, at most two copies per half
+	if (size > _block_elements)
+	{
+		throw config_error("Block larger than ring_buffer block size");
+	}
+	long start = _curr_end + 1;
+	if (start == _capacity) { start = 0; }
+	long first_size = std::min(size, _capacity - start);
+	double* first = _ring_buffer.data() + start;
+	std::copy(data, data + first_size, first);
+	std::copy(data, data + first_size, first + _capacity);
+	std::copy(data + first_size, data + size, _ring_buffer.data());
+	std::copy(data + first_size, data + size,
+		_ring_buffer.data() + _capacity);
+	_curr_end += size;
+	if (_curr_end >= _capacity) { _curr_end -= _capacity; }
+
+	return;
+}
+
+void ring_buffer::Insert_Zeros(long size)
+{
+	// Req: size [0, Block_Size()]
+	if (size > _block_elements)
+	{
+		throw config_error("Block larger than ring_buffer block size");
+	}
+	long start = _curr_end + 1;
+	if (start == _capacity) { start = 0; }
+	long first_size = std::min(size, _capacity - start);
+	double* first = _ring_buffer.data() + start;
+	std::fill(first, first + first_size, 0.0);
+	std::fill(first + _capacity, first + _capacity + first_size, 0.0);
+	std::fill(_ring_buffer.data(), _ring_buffer.data() + size - first_size,
+		0.0);
+	std::fill(_ring_buffer.data() + _capacity,
+		_ring_buffer.data() + _capacity + size - first_size, 0.0);
+	_curr_end += size;
+	if (_curr_end >= _capacity) { _curr_end -= _capacity; }
 
 	return;
 }
 
 void ring_buffer::Clear()
 {
+	// Prom: same state as Configure(...), so results do not depend on
+	// where the previous use of the buffer stopped
 	for (auto& element : _ring_buffer) { element = 0.0; }
+	_curr_end = _capacity - 1;
 	
 	return;
 }
 
 long ring_buffer::Size() const
 {
-	// _ring_buffer.size() is never greater than LONG_MAX
-	return static_cast<long>(_ring_buffer.size());
+	// Prom: number of taps the buffer was configured for
+	return _total_elements;
+}
+
+long ring_buffer::Block_Size() const
+{
+	return _block_elements;
 }
 
 long ring_buffer::Max_Size() const
 {
-	auto rb_max_size = _ring_buffer.max_size();
+	auto rb_max_size = _ring_buffer.max_size() / 2;
 	if (rb_max_size > LONG_MAX) { return LONG_MAX; }
 	return static_cast<long>(rb_max_size);
 }
@@ -88,39 +176,104 @@ long ring_buffer::Load_Buffer(long non_causal_elements,
 	return samples_to_preload;
 }
 
-double ring_buffer::Process_Cycle(std::vector<double> const& full,
+double ring_buffer::Process_Cycle(std::vector<double> const& taps,
 	std::vector<double> const& causal)
 {
-	// Req: causal.size() <= full.size()
-	// Req: full.size() <= _total_elements
-	// Req: vectors size is less than LONG_MAX
-	// The summation error introduced
-	long total_elements = static_cast<long>(full.size());
+	return Process_Cycle(taps, causal, 0);
+}
+
+double ring_buffer::Process_Cycle(std::vector<double> const& taps,
+	std::vector<double> const& causal, long age)
+{
+	// Req: causal.size() <= taps.size()
+	// Req: taps.size() <= _total_elements
+	// Req: taps are ordered oldest sample first
+	// Req: age [0, Block_Size()), output for the sample inserted age
+	// samples before the newest one
+	// Req: taps are mirrored around the zeroth causal tap for the non
+	// causal taps, as built by firf_base::Get_Ring_Imp_Resp(...)
+	// The summation error introduced is bounded in mac_kernel.cpp
+	//
+	// Linear phase folding: the non causal taps mirror the first causal
+	// taps, so each mirrored pair of samples is added before multiplying
+	// with their shared tap. The remaining causal taps use a plain dot
+	// product. With delay_frac == 1.0 this halves the multiplications.
+	long total_elements = static_cast<long>(taps.size());
 	long causal_elements = static_cast<long>(causal.size());
 	long non_causal_elements = total_elements - causal_elements;
 	long causal_dif = _non_causal_elements - non_causal_elements;
-	double sum = 0.0;
-	for (long element = 0; element < full.size(); element++)
+	long window_start = _curr_end - age - causal_dif - total_elements + 1;
+	if (window_start < 0) { window_start += _capacity; }
+	double const* window = _ring_buffer.data() + window_start;
+	if (non_causal_elements == 0)
 	{
-		long buffer_index = element + causal_dif;
-		sum += Buffer_At(buffer_index) * full.at(element);
+		return _mac.Dot(window, taps.data(), total_elements);
 	}
+	long zeroth = causal_elements - 1;
+	long fold_start = zeroth - non_causal_elements;
+	double sum = _mac.Dot(window, taps.data(), fold_start);
+	sum += _mac.Dot_Folded(taps.data() + fold_start, window + fold_start,
+		window + zeroth + 1, non_causal_elements);
+	sum += taps[zeroth] * window[zeroth];
 
 	return sum;
 }
 
-void ring_buffer::Decrement_Curr_Indices()
+double ring_buffer::Process_Cycle_Unfolded(std::vector<double> const& taps,
+	std::vector<double> const& causal)
 {
-	_curr_start--;
-	_curr_zeroth--;
-	_curr_end--;
-	if (_curr_start < 0) { _curr_start += _total_elements; }
-	if (_curr_zeroth < 0) { _curr_zeroth += _total_elements; }
-	if (_curr_end < 0) { _curr_end += _total_elements; }
+	// Req: as Process_Cycle(...) without the mirroring, the non causal taps
+	// may differ from the causal taps they would mirror
+	// Prom: the plain dot product of all taps, aligned as Process_Cycle(...)
+	long total_elements = static_cast<long>(taps.size());
+	long causal_elements = static_cast<long>(causal.size());
+	long non_causal_elements = total_elements - causal_elements;
+	long causal_dif = _non_causal_elements - non_causal_elements;
+	long window_start = _curr_end - causal_dif - total_elements + 1;
+	if (window_start < 0) { window_start += _capacity; }
+	double const* window = _ring_buffer.data() + window_start;
+
+	return _mac.Dot(window, taps.data(), total_elements);
+}
+
+void ring_buffer::Process_Cycles(std::vector<double> const& taps,
+	std::vector<double> const& causal, long count, double* results)
+{
+	// Req: as Process_Cycle(...), count [0, Block_Size()]
+	// Prom: results[n] is the output for the sample inserted count - 1 - n
+	// samples before the newest one, computed by the tiled kernel of
+	// mac_kernel, with the same folding as Process_Cycle(...)
+	// Prom: results do not depend on count, only on the samples
+	long total_elements = static_cast<long>(taps.size());
+	long causal_elements = static_cast<long>(causal.size());
+	long non_causal_elements = total_elements - causal_elements;
+	long causal_dif = _non_causal_elements - non_causal_elements;
+	long window_start = _curr_end - (count - 1) - causal_dif
+		- total_elements + 1;
+	if (window_start < 0) { window_start += _capacity; }
+	long plain = total_elements;
+	if (non_causal_elements > 0)
+	{
+		plain = causal_elements - 1 - non_causal_elements;
+	}
+	_mac.Dot_Tile(taps.data(), plain, non_causal_elements,
+		_ring_buffer.data() + window_start, count, results);
 
 	return;
 }
 
+void ring_buffer::Set_Isa(mac_isa isa)
+{
+	_mac.Configure(isa);
+
+	return;
+}
+
+mac_isa ring_buffer::Get_Isa() const
+{
+	return _mac.Get_Isa();
+}
+
 bool ring_buffer::Valid_Total_Elements(long total_elements)
 {
 	if (total_elements > 0 && total_elements < _ring_buffer.max_size())
@@ -129,15 +282,3 @@ bool ring_buffer::Valid_Total_Elements(long total_elements)
 	}
 	return false;
 }
-
-double ring_buffer::Buffer_At(long index)
-{
-	// Req: Valid_Ring_Buffer() && index < _index_max
-	long translated_index = index + _curr_start;
-	if (translated_index > _index_max)
-	{ 
-		translated_index -= _total_elements;
-	}
-
-	return _ring_buffer.at(translated_index);
-}
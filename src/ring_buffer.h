@@ -1,41 +1,58 @@
 #pragma once
 
+#include <algorithm>	// std::copy, std::fill, std::min
+#include <climits>
 #include <memory>
 #include <vector>
 
 #include "errors_custom.h"
-#include "wvt_win.h"
+#include "mac_kernel.h"
 
 class ring_buffer
 {
+public:
+	static constexpr long Block_Elements_Default = 256;
+
 private:
-	long _curr_start;
-	long _curr_zeroth;
 	long _curr_end;
-	long _index_max;
+	long _capacity;
+	long _block_elements;
 	long _total_elements;
 	long _non_causal_elements;
 	std::vector<double> _ring_buffer;
+	mac_kernel _mac;
 
 public:
 	ring_buffer();
 	ring_buffer(long total_elements, long causal_elements);
+	ring_buffer(long total_elements, long causal_elements,
+		long block_elements);
 
 public:
 	void Configure(long total_elements, long causal_elements);
+	void Configure(long total_elements, long causal_elements,
+		long block_elements);
 	void Insert(double value);
+	void Insert_Block(double const* data, long size);
+	void Insert_Zeros(long size);
 	void Clear();
 	long Size() const;
+	long Block_Size() const;
 	long Max_Size() const;
 	bool Valid_Ring_Buffer() const;
 	long Load_Buffer(long non_causal_elements,
 		std::vector<double> const& data);
-	double Process_Cycle(std::vector<double> const& full,
+	double Process_Cycle(std::vector<double> const& taps,
 		std::vector<double> const& causal);
+	double Process_Cycle(std::vector<double> const& taps,
+		std::vector<double> const& causal, long age);
+	double Process_Cycle_Unfolded(std::vector<double> const& taps,
+		std::vector<double> const& causal);
+	void Process_Cycles(std::vector<double> const& taps,
+		std::vector<double> const& causal, long count, double* results);
+	void Set_Isa(mac_isa isa);
+	mac_isa Get_Isa() const;
 
 private:
-	void Decrement_Curr_Indices();
 	bool Valid_Total_Elements(long total_elements);
-	double Buffer_At(long index);
 };
-
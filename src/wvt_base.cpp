@@ -2,7 +2,7 @@
 
 wvt_base::wvt_base() noexcept :
 	_samplerate(0.0), _error_max(0.0),
-	_freq_base(0.0), _accu_samples(0.0) {}
+	_freq_base(0.0), _accu_samples(0.0), _lookup(wvt_lookup::nearest) {}
 
 bool wvt_base::Valid_Freq_Input(double freq) const
 {
@@ -24,6 +24,11 @@ bool wvt_base::Valid_Wvt() const
 	return false;
 }
 
+wvt_lookup wvt_base::Get_Lookup() const
+{
+	return _lookup;
+}
+
 void wvt_base::Set_Samplerate(double samplerate)
 {
 	if (!Valid_Samplerate(samplerate))
@@ -47,6 +52,19 @@ void wvt_base::Set_Error_Max(double max_error)
 	return;
 }
 
+void wvt_base::Set_Lookup(wvt_lookup lookup)
+{
+	// Req: called before Determine_Samples_To_Allocate()
+	// Prom: wvt_lookup::linear interpolates between the two neighbouring
+	// elements, which lets the table shrink from 1 / error to
+	// 1 / sqrt(error) elements
+	// Prom: wvt_lookup::direct allocates no table and evaluates the
+	// function for every sample, within a few DBL_EPSILON
+	_lookup = lookup;
+
+	return;
+}
+
 void wvt_base::Set_Freq_Base(double table_samples)
 {
 	// Req: Valid_Max_Error(_max_error) && Valid_Samplerate(_samplerate)
@@ -56,6 +74,20 @@ void wvt_base::Set_Freq_Base(double table_samples)
 	return;
 }
 
+double wvt_base::Interpolate(double const* wvt, long size,
+	double position) const
+{
+	// Req: wvt holds size elements, position [0, size)
+	// Prom: linear interpolation of the elements around position, the
+	// element after the last is the first, which only periodic tables
+	// reach with a non zero fraction
+	long index = static_cast<long>(position);
+	long next = index + 1;
+	if (next == size) { next = 0; }
+
+	return wvt[index] + (wvt[next] - wvt[index]) * (position - index);
+}
+
 bool wvt_base::Valid_Table_Size_Cast(double table_samples) const
 {
 	// Prom: _wvt size can safetly be casted to double
@@ -65,7 +97,7 @@ bool wvt_base::Valid_Table_Size_Cast(double table_samples) const
 		&& table_samples >= 0.0
 		&& table_samples < std::pow(FLT_RADIX, DBL_MANT_DIG - 1)
 		&& table_samples <= LONG_MAX
-		&& table_samples <= _wvt.max_size())
+		&& table_samples <= std::vector<double>().max_size())
 	{
 		return true;
 	}
@@ -79,7 +111,7 @@ bool wvt_base::Valid_Table_Size_Cast(long table_samples) const
 	if (table_samples >= 0.0
 		&& table_samples < std::pow(FLT_RADIX, DBL_MANT_DIG - 1)
 		&& table_samples < LONG_MAX
-		&& table_samples <= _wvt.max_size())
+		&& table_samples <= std::vector<double>().max_size())
 	{
 		return true;
 	}
@@ -127,9 +159,10 @@ bool wvt_base::Valid_Samplerate(double samplerate) const
 
 bool wvt_base::Populated_Wvt() const
 {
-	if (_wvt.size() != 0)
+	if (_lookup == wvt_lookup::direct) { return true; }
+	if (_wvt && _wvt->Size() != 0)
 	{
-		for (auto const& sample : _wvt)
+		for (auto const& sample : *_wvt)
 		{
 			if (sample != 0) { return true; }
 		}
@@ -2,12 +2,16 @@
 
 #include <cfloat>
 #include <climits>
-#include <cmath>	// std::ceil, std::floor, std::fmod
-#include <memory>	// std::unique_ptr
+#include <cmath>	// std::ceil, std::floor, std::fmod, std::sqrt
+#include <memory>	// std::unique_ptr, std::shared_ptr
 #include <vector>
 
 #include "errors_custom.h"
 #include "pi_fir.h"
+#include "wvt_registry.h"
+#include "wvt_table.h"
+
+enum class wvt_lookup { nearest, linear, direct };
 
 class wvt_base
 {
@@ -16,7 +20,8 @@ protected:
 	double _error_max;
 	double _freq_base;
 	double _accu_samples;
-	std::vector<double> _wvt;
+	wvt_lookup _lookup;
+	wvt_registry::table _wvt;
 
 protected:
 	wvt_base() noexcept;
@@ -24,13 +29,16 @@ protected:
 public:
 	bool Valid_Wvt() const;
 	bool Valid_Freq_Input(double freq) const;
+	wvt_lookup Get_Lookup() const;
 
 protected:
 	void Set_Samplerate(double samplerate);
+	void Set_Lookup(wvt_lookup lookup);
 	void Set_Error_Max(double error_max);
 	virtual double Determine_Samples_To_Allocate() const = 0;
 	virtual void Set_Accu_Samples(double table_samples) = 0;
 	void Set_Freq_Base(double table_samples);
+	double Interpolate(double const* wvt, long size, double position) const;
 	virtual void Create_Wvt(double table_samples, long accu_check_samples) = 0;
 
 protected:
@@ -1,7 +1,7 @@
 #include "wvt_cos.h"
 
 wvt_cos::wvt_cos() noexcept :
-	wvt_base() {}
+	wvt_base(), _period(0.0), _quarter(0), _quarter_inv(0.0) {}
 
 wvt_cos::wvt_cos(double samplerate, double error_max,
 	long output_samples_max) :
@@ -14,10 +14,19 @@ wvt_cos::wvt_cos(double samplerate, double error_max,
 
 void wvt_cos::Configure(double samplerate, double error_max,
 	long output_samples_max)
+{
+	Configure(samplerate, error_max, output_samples_max, wvt_lookup::nearest);
+
+	return;
+}
+
+void wvt_cos::Configure(double samplerate, double error_max,
+	long output_samples_max, wvt_lookup lookup)
 {
 	auto temp_wvt = std::make_unique<wvt_cos>();
 	temp_wvt->Set_Samplerate(samplerate);
 	temp_wvt->Set_Error_Max(error_max);
+	temp_wvt->Set_Lookup(lookup);
 	double table_samples = temp_wvt->Determine_Samples_To_Allocate();
 	temp_wvt->Set_Freq_Base(table_samples);
 	temp_wvt->Set_Accu_Samples(table_samples);
@@ -29,36 +38,115 @@ void wvt_cos::Configure(double samplerate, double error_max,
 
 std::vector<double> wvt_cos::Get_Causal_Cos(double freq,
 	std::vector<double>::size_type total_samples)
+{
+	std::vector<double> sinusoid;
+	Get_Causal_Cos(freq, total_samples, sinusoid);
+
+	return sinusoid;
+}
+
+void wvt_cos::Get_Causal_Cos(double freq,
+	std::vector<double>::size_type total_samples,
+	std::vector<double>& sinusoid)
 {
 	// Req: Valid_Wvt_Cos() && Valid_Table_Size_Cast(total_samples)
 	// Req: Valid_Freq_Input(freq)
 	// Req: total_sampes <= _accu_samples
+	// Prom: no allocation once sinusoid has total_samples capacity
 	//
 	// Iterative floating point inaccuracy introduced during for loop
 	// This inaccuracy is quantified in Set_Accu_Samples()
-	std::vector<double> sinusoid(total_samples, 0.0);
-	double sample_fp = 0.0;
-	double dsample = freq / _freq_base;
-	double total_samples_fp = static_cast<double>(total_samples);
-	for (long sample = 0; sample < sinusoid.size(); sample++)
+	sinusoid.resize(total_samples);
+	if (_lookup == wvt_lookup::direct)
+	{
+		// The phase of every sample from its own product, no drift
+		for (long sample = 0; sample < sinusoid.size(); sample++)
+		{
+			double phase = std::fmod(sample * freq, _samplerate);
+			sinusoid.at(sample) = std::cos(2.0 * PI_FIR * phase
+				/ _samplerate);
+		}
+	}
+	else
 	{
-		sinusoid.at(sample) = _wvt.at(static_cast<long>(sample_fp));
-		sample_fp += dsample;
-		if (sample_fp >= _wvt.size()) { sample_fp -= _wvt.size(); }
+		wvt_table const& wvt = *_wvt;
+		double sample_fp = 0.0;
+		double dsample = freq / _freq_base;
+		for (long sample = 0; sample < sinusoid.size(); sample++)
+		{
+			sinusoid.at(sample) = Quarter_Lookup(wvt.Data(), sample_fp);
+			sample_fp += dsample;
+			if (sample_fp >= _period) { sample_fp -= _period; }
+		}
 	}
 
-	return sinusoid;
+	return;
+}
+
+double wvt_cos::Position_Step(double freq) const
+{
+	// Req: Valid_Freq_Input(freq)
+	// Prom: table positions per sample of a sinusoid of freq
+	return freq / _freq_base;
+}
+
+double wvt_cos::Advance_Position(double position, double step) const
+{
+	// Req: position [0, period), step [0, period / 2), the period is four
+	// times the quarter stored, or the samplerate for direct lookup
+	// Prom: position + step wrapped to [0, period)
+	position += step;
+	if (position >= _period) { position -= _period; }
+
+	return position;
+}
+
+void wvt_cos::Get_Quadrature(double position, double& cosine,
+	double& sine) const
+{
+	// Req: position [0, period)
+	// Prom: cos and sin of the phase at position, the sine read a quarter
+	// period before, which is a whole number of elements
+	if (_lookup == wvt_lookup::direct)
+	{
+		double phase = 2.0 * PI_FIR * position / _period;
+		cosine = std::cos(phase);
+		sine = std::sin(phase);
+	}
+	else
+	{
+		wvt_table const& wvt = *_wvt;
+		double sine_position = position - _quarter;
+		if (sine_position < 0.0) { sine_position += _period; }
+		cosine = Quarter_Lookup(wvt.Data(), position);
+		sine = Quarter_Lookup(wvt.Data(), sine_position);
+	}
+
+	return;
 }
 
 double wvt_cos::Determine_Samples_To_Allocate() const
 {
 	// Req: Valid_Max_Error(_max_error)
 	// Prom: cos(n * pi / 2) is exactly represented in table, n[0, 4)
+	// Prom: table_samples is the period, a multiple of 4 so the stored
+	// quarter ends on an element
 	// Prom: table size set so Create_Wvt(...) is within _max_error bounds
 	// Prom: calculation uses abs max of derivative of Create_Wvt(...)
 	// Prom: sizing takes into account a full element drift (so it's x2)
-	double table_samples = std::ceil(2.0 * PI_FIR / _error_max);
-	if (fmod(table_samples, 2.0) != 0.0) { table_samples += 1.0; }
+	//
+	// Linear lookup: the interpolation error is h^2 / 8 * max|f''| with
+	// h = 1 / table_samples and max|f''| = (2 * pi)^2, held to half of
+	// _error_max, the other half is left to the access drift
+	//
+	// Direct lookup: no table, positions are counted in cycles times the
+	// samplerate, so _freq_base is 1 Hz
+	double table_samples = 4.0 * std::ceil(2.0 * PI_FIR / _error_max / 4.0);
+	if (_lookup == wvt_lookup::linear)
+	{
+		table_samples = 4.0 * std::ceil(PI_FIR / std::sqrt(_error_max) / 4.0);
+	}
+	if (_lookup == wvt_lookup::direct) { table_samples = _samplerate; }
 	if (!Valid_Table_Size_Cast(table_samples))
 	{
 		throw config_error(
@@ -72,9 +160,25 @@ void wvt_cos::Set_Accu_Samples(double table_samples)
 {
 	// Sets _accu_samples to threshold that ensures wavetable element access
 	// has not drifted a full element
-	_accu_samples = std::floor(
-		1.0 / ((4.0 * DBL_EPSILON * table_samples) + (2.0 * DBL_EPSILON))
+	//
+	// Linear lookup: the drift may only cost the half of _error_max the
+	// interpolation leaves, error_max * table_samples / (4 * pi) elements
+	// at a slope of 2 * pi / table_samples per element
+	//
+	// Direct lookup: Get_Causal_Cos(...) does not iterate the position
+	double drift_max = 1.0;
+	if (_lookup == wvt_lookup::linear)
+	{
+		drift_max = std::fmin(1.0,
+			_error_max * table_samples / (4.0 * PI_FIR));
+	}
+	_accu_samples = std::floor(drift_max
+		/ ((4.0 * DBL_EPSILON * table_samples) + (2.0 * DBL_EPSILON))
 	);
+	if (_lookup == wvt_lookup::direct)
+	{
+		_accu_samples = std::floor(1.0 / DBL_EPSILON);
+	}
 
 	return;
 }
@@ -83,18 +187,60 @@ void wvt_cos::Create_Wvt(double table_samples, long output_samples_max)
 {
 	// Prom: cos revolution [0.0, 2.0 * pi) within _error_max bounds
 	// Prom: n * pi / 2 is exactly represented in table, n[0, 4)
+	// Prom: only the quarter [0.0, pi / 2] is stored, table_samples / 4 + 1
+	// elements, Quarter_Lookup(...) reflects the other quadrants into it
 	if (!Valid_Table_Size_Alloc(table_samples)
 		|| !Valid_Table_Size_Alloc(output_samples_max))
 	{
 		throw accuracy_error(
 			"Invalid table size - resulting error greater than _error_max");
 	}
-	_wvt = std::vector<double>(static_cast<long>(table_samples), 0.0);
-	for (long sample = 0; sample < _wvt.size(); sample++)
+	_period = table_samples;
+	if (_lookup == wvt_lookup::direct) { return; }
+	_wvt = wvt_registry::Acquire(
+		std::make_tuple(wvt_kind::cos, table_samples, 0.0),
+		[table_samples](std::vector<double>& wvt)
 	{
-		double sample_fp = sample;
-		_wvt.at(sample) = std::cos(2.0 * PI_FIR * sample_fp / table_samples);
-	}
+		long quarter = static_cast<long>(table_samples) / 4;
+		wvt.assign(quarter + 1, 0.0);
+		for (long sample = 0; sample < quarter; sample++)
+		{
+			double sample_fp = sample;
+			wvt.at(sample) = std::cos(2.0 * PI_FIR * sample_fp
+				/ table_samples);
+		}
+	});
+	_quarter = static_cast<long>(table_samples) / 4;
+	_quarter_inv = 1.0 / _quarter;
 
 	return;
+}
+
+double wvt_cos::Quarter_Lookup(double const* wvt, double position) const
+{
+	// Req: wvt holds the _quarter + 1 elements of [0.0, pi / 2], position
+	// [0, 4 * _quarter)
+	// Prom: the element of the full revolution at position, or the linear
+	// interpolation at it, the same values as a full table
+	//
+	// Without branches: quadrants 1 and 3 read the quarter backwards from
+	// its end, quadrants 1 and 2 are negated. Within a quadrant the
+	// reflection is affine, so it commutes with the interpolation. The
+	// quadrant comes from a product instead of a division, rounding down
+	// on a quadrant boundary gives an offset of _quarter, which reads the
+	// same value as the next quadrant
+	long index = static_cast<long>(position);
+	long quadrant = static_cast<long>(index * _quarter_inv);
+	long start = quadrant * _quarter;
+	double offset = static_cast<double>(index - start);
+	if (_lookup == wvt_lookup::linear) { offset = position - start; }
+	double reversed = static_cast<double>(quadrant & 1);
+	double element = offset + reversed * (_quarter - 2.0 * offset);
+	double sign = 1.0 - 2.0 * static_cast<double>(((quadrant + 1) >> 1) & 1);
+	if (_lookup == wvt_lookup::linear)
+	{
+		return sign * Interpolate(wvt, _quarter + 1, element);
+	}
+
+	return sign * wvt[static_cast<long>(element)];
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <cmath>	// std::cos()
+#include <cmath>	// std::cos(), std::sin(), std::fmod()
 #include <memory>	// std::unique_ptr
 #include <vector>
 
@@ -10,6 +10,11 @@
 
 class wvt_cos : public wvt_base
 {
+private:
+	double _period;
+	long _quarter;
+	double _quarter_inv;
+
 public:
 	wvt_cos() noexcept;
 	wvt_cos(double samplerate, double error_max, long output_samples_max);
@@ -17,11 +22,21 @@ public:
 public:
 	void Configure(double samplerate, double error_max,
 		long output_samples_max);
+	void Configure(double samplerate, double error_max,
+		long output_samples_max, wvt_lookup lookup);
 	std::vector<double> Get_Causal_Cos(double freq,
 		std::vector<double>::size_type total_samples);
+	void Get_Causal_Cos(double freq,
+		std::vector<double>::size_type total_samples,
+		std::vector<double>& sinusoid);
+	double Position_Step(double freq) const;
+	double Advance_Position(double position, double step) const;
+	void Get_Quadrature(double position, double& cosine,
+		double& sine) const;
 
 private:
 	double Determine_Samples_To_Allocate() const override;
 	void Set_Accu_Samples(double table_samples) override;
 	void Create_Wvt(double table_samples, long output_samples_max) override;
+	double Quarter_Lookup(double const* wvt, double position) const;
 };
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "wvt_registry.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>		// open
+#include <sys/mman.h>	// mmap
+#include <sys/stat.h>	// fstat
+#include <unistd.h>		// close, getpid
+#define FIRF_WVT_MMAP
+#endif
+
+// Shared wavetables
+//
+// A wavetable only depends on its kind, its size and, for the window, the
+// power, so every wvt_* with the same table_key can read the same table.
+// The registry maps each key to a weak reference of its table: the wvt_*
+// instances own the tables, a table is freed with the last instance using
+// it, and memory grows with the distinct configurations in use rather
+// than the number of filters. A configuration whose table is alive costs
+// a lookup instead of a table synthesis. Tables are immutable once
+// created, so instances read them concurrently without locking; the
+// registry itself is guarded by a mutex, which is also held while a table
+// is created so a configuration is never synthesized twice.
+//
+// Cache files
+//
+// With a cache directory set, a table that is not alive is mapped read
+// only from its file in the directory, so later runs skip the synthesis
+// and processes mapping the same file share its pages. The file holds a
+// header of Cache_Header_Bytes (magic, Cache_File_Version, the key, the
+// number of values, a probe value for the double layout and a 64 bit
+// FNV-1a checksum over the words of the values) followed by the values.
+// A file that is missing, of another version, key or layout, truncated or
+// failing its checksum is ignored: the table is synthesized and the file
+// rewritten, through a temporary file renamed into place so readers never
+// see a partial file. Failing to write the cache only loses the cache.
+// Without mmap (FIRF_WVT_MMAP undefined) the cache directory is ignored.
+
+wvt_registry::table wvt_registry::Acquire(table_key const& key,
+	std::function<void(std::vector<double>&)> const& create)
+{
+	// Req: create(...) fills the table of key
+	// Prom: the live table of key, else the table of its cache file, else
+	// a new table from create(...)
+	static_assert(sizeof(cache_header) == Cache_Header_Bytes,
+		"Cache header layout");
+	std::lock_guard<std::mutex> lock(Registry_Mutex());
+	auto& tables = Registry_Tables();
+	auto found = tables.find(key);
+	if (found != tables.end())
+	{
+		table shared = found->second.lock();
+		if (shared) { return shared; }
+	}
+	table shared = Load_Cache_File(key);
+	if (!shared)
+	{
+		std::vector<double> values;
+		create(values);
+		Store_Cache_File(key, values);
+		shared = std::make_shared<wvt_table const>(std::move(values));
+	}
+	tables[key] = shared;
+
+	// Entries of freed tables
+	for (auto entry = tables.begin(); entry != tables.end();)
+	{
+		if (entry->second.expired()) { entry = tables.erase(entry); }
+		else { entry++; }
+	}
+
+	return shared;
+}
+
+long wvt_registry::Get_Tables()
+{
+	// Prom: tables alive in the process
+	std::lock_guard<std::mutex> lock(Registry_Mutex());
+	long tables = 0;
+	for (auto const& entry : Registry_Tables())
+	{
+		if (!entry.second.expired()) { tables++; }
+	}
+
+	return tables;
+}
+
+long wvt_registry::Get_Bytes()
+{
+	// Prom: memory held by the tables alive in the process, mapped tables
+	// included
+	std::lock_guard<std::mutex> lock(Registry_Mutex());
+	long bytes = 0;
+	for (auto const& entry : Registry_Tables())
+	{
+		table shared = entry.second.lock();
+		if (shared)
+		{
+			bytes += shared->Size() * static_cast<long>(sizeof(double));
+		}
+	}
+
+	return bytes;
+}
+
+void wvt_registry::Set_Cache_Directory(std::string const& directory)
+{
+	// Req: directory exists, "" disables the cache (the default)
+	// Prom: tables acquired from now on are read from and written to it
+	std::lock_guard<std::mutex> lock(Registry_Mutex());
+	Registry_Directory() = directory;
+
+	return;
+}
+
+std::string wvt_registry::Get_Cache_Directory()
+{
+	std::lock_guard<std::mutex> lock(Registry_Mutex());
+
+	return Registry_Directory();
+}
+
+std::mutex& wvt_registry::Registry_Mutex()
+{
+	static std::mutex registry_mutex;
+
+	return registry_mutex;
+}
+
+std::map<wvt_registry::table_key, std::weak_ptr<wvt_table const>>&
+	wvt_registry::Registry_Tables()
+{
+	static std::map<table_key, std::weak_ptr<wvt_table const>>
+		registry_tables;
+
+	return registry_tables;
+}
+
+std::string& wvt_registry::Registry_Directory()
+{
+	static std::string registry_directory;
+
+	return registry_directory;
+}
+
+std::string wvt_registry::Cache_File_Path(table_key const& key)
+{
+	// Req: Registry_Directory() not empty
+	// Prom: file name from the key, the power by its bits
+	static char const* const kind_names[] = { "sinc", "win", "cos" };
+	double pow = std::get<2>(key);
+	std::uint64_t pow_bits = 0;
+	std::memcpy(&pow_bits, &pow, sizeof(pow_bits));
+	char name[96];
+	std::snprintf(name, sizeof(name), "/wvt_%s_%.0f_%016llx_v%u.bin",
+		kind_names[static_cast<int>(std::get<0>(key))], std::get<1>(key),
+		static_cast<unsigned long long>(pow_bits),
+		static_cast<unsigned>(Cache_File_Version));
+
+	return Registry_Directory() + name;
+}
+
+std::uint64_t wvt_registry::Table_Values(table_key const& key)
+{
+	// Prom: number of values the table of key holds, the cos table stores
+	// only the quarter period and its end, table_samples / 4 + 1
+	std::uint64_t table_samples = static_cast<std::uint64_t>(
+		std::get<1>(key));
+	if (std::get<0>(key) == wvt_kind::cos) { return table_samples / 4 + 1; }
+
+	return table_samples;
+}
+
+wvt_registry::table wvt_registry::Load_Cache_File(table_key const& key)
+{
+	// Prom: mapped table of key, nullptr when there is no valid file
+#ifdef FIRF_WVT_MMAP
+	if (Registry_Directory().empty()) { return nullptr; }
+	int file = open(Cache_File_Path(key).c_str(), O_RDONLY);
+	if (file < 0) { return nullptr; }
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size < Cache_Header_Bytes)
+	{
+		close(file);
+		return nullptr;
+	}
+	long bytes = static_cast<long>(status.st_size);
+	void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (mapping == MAP_FAILED) { return nullptr; }
+	cache_header header;
+	std::memcpy(&header, mapping, sizeof(header));
+	unsigned char const* values = static_cast<unsigned char const*>(mapping)
+		+ Cache_Header_Bytes;
+	std::size_t values_bytes = static_cast<std::size_t>(bytes
+		- Cache_Header_Bytes);
+	if (std::memcmp(header.magic, "FIRFWVT", sizeof(header.magic)) != 0
+		|| header.version != Cache_File_Version
+		|| header.kind != static_cast<std::uint32_t>(std::get<0>(key))
+		|| header.table_samples != std::get<1>(key)
+		|| header.pow != std::get<2>(key)
+		|| header.probe != 1.0
+		|| header.values != Table_Values(key)
+		|| header.values * sizeof(double) != values_bytes
+		|| header.checksum != Checksum(values, values_bytes))
+	{
+		munmap(mapping, bytes);
+		return nullptr;
+	}
+
+	return std::make_shared<wvt_table const>(mapping, bytes,
+		static_cast<long>(Cache_Header_Bytes),
+		static_cast<long>(header.values));
+#else
+	return nullptr;
+#endif
+}
+
+void wvt_registry::Store_Cache_File(table_key const& key,
+	std::vector<double> const& values)
+{
+	// Prom: writes the cache file of key when a cache directory is set,
+	// errors leave no file behind
+#ifdef FIRF_WVT_MMAP
+	if (Registry_Directory().empty()) { return; }
+	cache_header header = {};
+	std::memcpy(header.magic, "FIRFWVT", sizeof(header.magic));
+	header.version = Cache_File_Version;
+	header.kind = static_cast<std::uint32_t>(std::get<0>(key));
+	header.table_samples = std::get<1>(key);
+	header.pow = std::get<2>(key);
+	header.values = values.size();
+	header.probe = 1.0;
+	header.checksum = Checksum(
+		reinterpret_cast<unsigned char const*>(values.data()),
+		values.size() * sizeof(double));
+	std::string path = Cache_File_Path(key);
+	std::string temp_path = path + ".tmp"
+		+ std::to_string(static_cast<long>(getpid()));
+	std::FILE* file = std::fopen(temp_path.c_str(), "wb");
+	if (file == nullptr) { return; }
+	bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+		&& std::fwrite(values.data(), sizeof(double), values.size(), file)
+		== values.size();
+	if (std::fclose(file) != 0) { written = false; }
+	if (!written || std::rename(temp_path.c_str(), path.c_str()) != 0)
+	{
+		std::remove(temp_path.c_str());
+	}
+#endif
+
+	return;
+}
+
+std::uint64_t wvt_registry::Checksum(unsigned char const* data,
+	std::size_t size)
+{
+	// Prom: FNV-1a over the 64 bit words of the bytes, then the bytes of
+	// an incomplete last word
+	std::uint64_t hash = 14695981039346656037ULL;
+	std::size_t words = size / sizeof(std::uint64_t);
+	for (std::size_t word = 0; word < words; word++)
+	{
+		std::uint64_t value = 0;
+		std::memcpy(&value, data + word * sizeof(value), sizeof(value));
+		hash ^= value;
+		hash *= 1099511628211ULL;
+	}
+	for (std::size_t byte = words * sizeof(std::uint64_t); byte < size;
+		byte++)
+	{
+		hash ^= data[byte];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
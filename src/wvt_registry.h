@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>		// std::snprintf, std::rename, std::remove
+#include <cstring>		// std::memcmp, std::memcpy
+#include <functional>	// std::function
+#include <map>
+#include <memory>		// std::shared_ptr, std::weak_ptr
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "wvt_table.h"
+
+enum class wvt_kind { sinc, win, cos };
+
+class wvt_registry
+{
+public:
+	static constexpr std::uint32_t Cache_File_Version = 2;
+	using table = std::shared_ptr<wvt_table const>;
+	using table_key = std::tuple<wvt_kind, double, double>;
+
+public:
+	static table Acquire(table_key const& key,
+		std::function<void(std::vector<double>&)> const& create);
+	static long Get_Tables();
+	static long Get_Bytes();
+	static void Set_Cache_Directory(std::string const& directory);
+	static std::string Get_Cache_Directory();
+
+private:
+	static constexpr long Cache_Header_Bytes = 64;
+	struct cache_header
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t kind;
+		double table_samples;
+		double pow;
+		std::uint64_t values;
+		double probe;
+		std::uint64_t checksum;
+		char reserved[8];
+	};
+
+private:
+	static std::mutex& Registry_Mutex();
+	static std::map<table_key, std::weak_ptr<wvt_table const>>&
+		Registry_Tables();
+	static std::string& Registry_Directory();
+	static std::string Cache_File_Path(table_key const& key);
+	static std::uint64_t Table_Values(table_key const& key);
+	static table Load_Cache_File(table_key const& key);
+	static void Store_Cache_File(table_key const& key,
+		std::vector<double> const& values);
+	static std::uint64_t Checksum(unsigned char const* data, std::size_t size);
+};
@@ -14,12 +14,26 @@ wvt_sinc::wvt_sinc(double samplerate, double max_error,
 
 void wvt_sinc::Configure(double samplerate, double error_max,
 	long output_samples_max)
+{
+	Configure(samplerate, error_max, output_samples_max, wvt_lookup::nearest);
+
+	return;
+}
+
+void wvt_sinc::Configure(double samplerate, double error_max,
+	long output_samples_max, wvt_lookup lookup)
 {
 	auto temp_wvt = std::make_unique<wvt_sinc>();
 	temp_wvt->Set_Samplerate(samplerate);
 	temp_wvt->Set_Error_Max(error_max);
+	temp_wvt->Set_Lookup(lookup);
 	double table_samples = temp_wvt->Determine_Samples_To_Allocate();
-	temp_wvt->Set_Freq_Base(table_samples);
+	// The elements are 1 / (table_samples - 1) apart, the nearest lookup
+	// absorbs the shift of table_samples in its element of drift, the
+	// other lookups have no element to spare
+	double spacing_samples = table_samples;
+	if (lookup != wvt_lookup::nearest) { spacing_samples -= 1.0; }
+	temp_wvt->Set_Freq_Base(spacing_samples);
 	temp_wvt->Set_Accu_Samples(table_samples);
 	temp_wvt->Create_Wvt(table_samples, output_samples_max);
 	*this = *(temp_wvt.get());
@@ -29,25 +43,77 @@ void wvt_sinc::Configure(double samplerate, double error_max,
 
 std::vector<double> wvt_sinc::Get_Causal_Sinc_Rev(double freq,
 	long reserve_size)
+{
+	std::vector<double> sinc_rev;
+	Get_Causal_Sinc_Rev(freq, reserve_size, sinc_rev);
+
+	return sinc_rev;
+}
+
+void wvt_sinc::Get_Causal_Sinc_Rev(double freq, long reserve_size,
+	std::vector<double>& sinc_rev)
 {
 	// Req: Valid_Wvt_Cos()
 	// Req: Valid_Freq_Input(freq)
 	// Req: reserve_size (0, _accu_samples]
+	// Prom: no allocation once sinc_rev has reserve_size capacity
 	//
 	// Iterative floating point inaccuracy introduced during for loop
 	// This inaccuracy is quantified in Set_Accu_Samples()
-	std::vector<double> sinc_rev;
+	sinc_rev.clear();
 	sinc_rev.reserve(reserve_size);
 	double sample_fp = 0.0;
 	double dsample = freq / _freq_base;
-	while (sample_fp < _wvt.size() && sinc_rev.size() < reserve_size)
+	if (_lookup == wvt_lookup::direct)
+	{
+		// x = sample * freq / _samplerate, the sinc ends before x = 1, a
+		// zero x (freq 0) takes the limit 1
+		double samples_fp = reserve_size;
+		if (freq > 0.0)
+		{
+			samples_fp = std::fmin(samples_fp, std::ceil(_samplerate / freq));
+		}
+		sinc_rev.push_back(1.0);
+		for (long sample = 1; sample < samples_fp; sample++)
+		{
+			double x = 2.0 * PI_FIR * (sample * freq / _samplerate);
+			sinc_rev.push_back(x == 0.0 ? 1.0 : std::sin(x) / x);
+		}
+	}
+	else if (_lookup == wvt_lookup::linear)
 	{
-		long sample = static_cast<long>(sample_fp);
-		sinc_rev.push_back(_wvt.at(sample));
-		sample_fp += dsample;
+		// The sinc ends before the last element, the sample count is taken
+		// from the division so rounding of the iteration cannot add the
+		// sample on the last element when freq divides _samplerate
+		wvt_table const& wvt = *_wvt;
+		double const* data = wvt.Data();
+		long size = wvt.Size();
+		double last_fp = size - 1.0;
+		double samples_fp = reserve_size;
+		if (dsample > 0.0)
+		{
+			samples_fp = std::fmin(samples_fp, std::ceil(
+				last_fp / dsample * (1.0 - 8.0 * DBL_EPSILON)));
+		}
+		for (long sample = 0; sample < samples_fp; sample++)
+		{
+			sinc_rev.push_back(
+				Interpolate(data, size, std::fmin(sample_fp, last_fp)));
+			sample_fp += dsample;
+		}
+	}
+	else
+	{
+		wvt_table const& wvt = *_wvt;
+		while (sample_fp < wvt.Size() && sinc_rev.size() < reserve_size)
+		{
+			long sample = static_cast<long>(sample_fp);
+			sinc_rev.push_back(wvt.At(sample));
+			sample_fp += dsample;
+		}
 	}
 
-	return sinc_rev;
+	return;
 }
 
 double wvt_sinc::Determine_Samples_To_Allocate() const
@@ -58,9 +124,22 @@ double wvt_sinc::Determine_Samples_To_Allocate() const
 	// Prom: calculation uses abs max of derivative of Create_Wvt(...)
 	// Prom: table_samples is exactly representable by double, long and size_t
 	// Prom: sizing takes into account a full element drift (so it's x2)
+	//
+	// Linear lookup: the interpolation error is h^2 / 8 * max|f''| with
+	// h = 1 / (table_samples - 1) and max|f''| = (2 * pi)^2 / 3, held to
+	// half of _error_max, the other half is left to the access drift
 	double table_samples = std::ceil(PI_FIR / (2.0 * _error_max));
+	if (_lookup == wvt_lookup::linear)
+	{
+		table_samples = std::ceil(PI_FIR / std::sqrt(3.0 * _error_max));
+	}
 	if (fmod(table_samples, 2.0) != 0.0) { table_samples += 1.0; }
 	table_samples += 1.0;
+	if (_lookup == wvt_lookup::direct)
+	{
+		// No table, elements 1 Hz apart so _freq_base is 1 Hz
+		table_samples = _samplerate + 1.0;
+	}
 	if (!Valid_Table_Size_Cast(table_samples))
 	{
 		throw config_error(
@@ -74,9 +153,23 @@ void wvt_sinc::Set_Accu_Samples(double table_samples)
 {
 	// Sets _accu_samples to threshold that ensures wavetable element access
 	// has not drifted a full element
-	_accu_samples = std::floor(
-		1.0 / ((2.0 * DBL_EPSILON * table_samples) + (2.0 * DBL_EPSILON))
+	//
+	// Linear lookup: the drift may only cost the half of _error_max the
+	// interpolation leaves, error_max * (table_samples - 1) / (2 * pi)
+	// elements at a slope below pi / (table_samples - 1) per element
+	double drift_max = 1.0;
+	if (_lookup == wvt_lookup::linear)
+	{
+		drift_max = std::fmin(1.0,
+			_error_max * (table_samples - 1.0) / (2.0 * PI_FIR));
+	}
+	_accu_samples = std::floor(drift_max
+		/ ((2.0 * DBL_EPSILON * table_samples) + (2.0 * DBL_EPSILON))
 	);
+	if (_lookup == wvt_lookup::direct)
+	{
+		_accu_samples = std::floor(1.0 / DBL_EPSILON);
+	}
 
 	return;
 }
@@ -91,15 +184,21 @@ void wvt_sinc::Create_Wvt(double table_samples, long output_samples_max)
 		throw accuracy_error(
 			"Invalid table size - resulting error greater than _error_max");
 	}
-	_wvt = std::vector<double>(static_cast<long>(table_samples), 0.0);
-	_wvt.at(0) = 1.0;
-	double table_samples_fp = table_samples - 1.0;
-	for (long sample = 1; sample < _wvt.size(); sample++)
+	if (_lookup == wvt_lookup::direct) { return; }
+	_wvt = wvt_registry::Acquire(
+		std::make_tuple(wvt_kind::sinc, table_samples, 0.0),
+		[table_samples](std::vector<double>& wvt)
 	{
-		double sample_fp = static_cast<double>(sample);
-		double x = sample_fp / table_samples_fp;
-		_wvt.at(sample) = std::sin(2.0 * PI_FIR * x) / (2.0 * PI_FIR * x);
-	}
+		wvt.assign(static_cast<long>(table_samples), 0.0);
+		wvt.at(0) = 1.0;
+		double table_samples_fp = table_samples - 1.0;
+		for (long sample = 1; sample < wvt.size(); sample++)
+		{
+			double sample_fp = static_cast<double>(sample);
+			double x = sample_fp / table_samples_fp;
+			wvt.at(sample) = std::sin(2.0 * PI_FIR * x) / (2.0 * PI_FIR * x);
+		}
+	});
 
 	return;
 }
\ No newline at end of file
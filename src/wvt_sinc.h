@@ -17,7 +17,11 @@ public:
 public:
 	void Configure(double samplerate, double error_max,
 		long output_samples_max);
+	void Configure(double samplerate, double error_max,
+		long output_samples_max, wvt_lookup lookup);
 	std::vector<double> Get_Causal_Sinc_Rev(double freq, long reserve_size);
+	void Get_Causal_Sinc_Rev(double freq, long reserve_size,
+		std::vector<double>& sinc_rev);
 
 private:
 	double Determine_Samples_To_Allocate() const override;
@@ -0,0 +1,87 @@
+#include "wvt_table.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>	// munmap
+#endif
+
+// Immutable table storage
+//
+// A table either owns its values or reads them from a read only file
+// mapping of the wavetable cache (see wvt_registry.cpp), which the
+// operating system shares between the processes mapping the same file.
+// The mapping is released with the table.
+
+wvt_table::wvt_table(std::vector<double>&& values) :
+	_values(std::move(values)), _mapping(nullptr), _mapping_bytes(0),
+	_data(nullptr), _size(0)
+{
+	_data = _values.data();
+	_size = static_cast<long>(_values.size());
+
+	return;
+}
+
+wvt_table::wvt_table(void const* mapping, long mapping_bytes,
+	long data_offset, long size) :
+	_mapping(mapping), _mapping_bytes(mapping_bytes), _data(nullptr),
+	_size(size)
+{
+	// Req: mapping of mapping_bytes holds size doubles at data_offset,
+	// aligned for double
+	_data = reinterpret_cast<double const*>(
+		static_cast<char const*>(mapping) + data_offset);
+
+	return;
+}
+
+wvt_table::~wvt_table()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	if (_mapping != nullptr)
+	{
+		munmap(const_cast<void*>(_mapping), _mapping_bytes);
+	}
+#endif
+
+	return;
+}
+
+long wvt_table::Size() const
+{
+	return _size;
+}
+
+double wvt_table::At(long index) const
+{
+	if (index < 0 || index >= _size)
+	{
+		throw std::out_of_range("Wavetable index out of range");
+	}
+
+	return _data[index];
+}
+
+double wvt_table::operator[](long index) const
+{
+	return _data[index];
+}
+
+double const* wvt_table::Data() const
+{
+	return _data;
+}
+
+bool wvt_table::Mapped() const
+{
+	return _mapping != nullptr;
+}
+
+double const* wvt_table::begin() const
+{
+	return _data;
+}
+
+double const* wvt_table::end() const
+{
+	return _data + _size;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdexcept>	// std::out_of_range
+#include <vector>
+
+class wvt_table
+{
+private:
+	std::vector<double> _values;
+	void const* _mapping;
+	long _mapping_bytes;
+	double const* _data;
+	long _size;
+
+public:
+	explicit wvt_table(std::vector<double>&& values);
+	wvt_table(void const* mapping, long mapping_bytes, long data_offset,
+		long size);
+	wvt_table(wvt_table const&) = delete;
+	wvt_table& operator=(wvt_table const&) = delete;
+	~wvt_table();
+
+public:
+	long Size() const;
+	double At(long index) const;
+	double operator[](long index) const;
+	double const* Data() const;
+	bool Mapped() const;
+	double const* begin() const;
+	double const* end() const;
+};
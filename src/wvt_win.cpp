@@ -12,11 +12,20 @@ wvt_win::wvt_win(double samplerate, double error_max, double pow) :
 }
 
 void wvt_win::Configure(double samplerate, double error_max, double pow)
+{
+	Configure(samplerate, error_max, pow, wvt_lookup::nearest);
+
+	return;
+}
+
+void wvt_win::Configure(double samplerate, double error_max, double pow,
+	wvt_lookup lookup)
 {
 	auto temp_wvt = std::make_unique<wvt_win>();
 	temp_wvt->Set_Samplerate(samplerate);
 	temp_wvt->Set_Power(pow);
 	temp_wvt->Set_Error_Max(error_max, pow);
+	temp_wvt->Set_Lookup(lookup);
 	double table_samples = temp_wvt->Determine_Samples_To_Allocate();
 	temp_wvt->Set_Freq_Base(table_samples);
 	temp_wvt->Set_Accu_Samples(table_samples);
@@ -28,19 +37,47 @@ void wvt_win::Configure(double samplerate, double error_max, double pow)
 
 std::vector<double> wvt_win::Get_Causal_Window(
 	std::vector<double>::size_type total_samples)
+{
+	std::vector<double> window;
+	Get_Causal_Window(total_samples, window);
+
+	return window;
+}
+
+void wvt_win::Get_Causal_Window(std::vector<double>::size_type total_samples,
+	std::vector<double>& window)
 {
 	// Req: Valid_Wvt() && Valid_Table_Size_(total_samples)
-	std::vector<double> window(total_samples, 0.0);
+	// Prom: no allocation once window has total_samples capacity
+	window.resize(total_samples);
 	double N = total_samples - 1.0;
-	double wvt_max_index = _wvt.size() - 1.0;
-	for (long sample = 0; sample < total_samples; sample++)
+	if (_lookup == wvt_lookup::direct)
 	{
-		double n = sample;
-		long wvt_index = static_cast<long>((n / N) * wvt_max_index);
-		window.at(sample) = _wvt.at(wvt_index);
+		for (long sample = 0; sample < total_samples; sample++)
+		{
+			double n = sample;
+			double x = N > 0.0 ? n / N : 0.0;
+			window.at(sample) = Power(std::cos(0.5 * PI_FIR * x), _pow);
+		}
+	}
+	else
+	{
+		wvt_table const& wvt = *_wvt;
+		double wvt_max_index = wvt.Size() - 1.0;
+		bool linear = _lookup == wvt_lookup::linear;
+		double const* data = wvt.Data();
+		long size = wvt.Size();
+		for (long sample = 0; sample < total_samples; sample++)
+		{
+			double n = sample;
+			double wvt_position = (n / N) * wvt_max_index;
+			window.at(sample) = linear
+				? Interpolate(data, size, wvt_position)
+				: wvt.At(static_cast<long>(wvt_position));
+		}
 	}
 	
-	return window;
+	return;
 }
 
 double wvt_win::Determine_Samples_To_Allocate() const
@@ -58,6 +95,20 @@ double wvt_win::Determine_Samples_To_Allocate() const
 		table_samples *= 0.25;
 		table_samples += 1.0;
 	}
+	if (_lookup == wvt_lookup::linear && (_pow == 1.0 || _pow >= 2.0))
+	{
+		// Linear lookup: the interpolation error h^2 / 8 * max|f''| with
+		// h = 1 / (table_samples - 1) and max|f''| = (pi / 2)^2 * _pow
+		// * max(_pow - 1, 1), held to half of _error_max. For other
+		// powers f'' is unbounded at the end of the window, the nearest
+		// sizing also bounds the linear lookup of the monotone window
+		double curvature = _pow * std::fmax(_pow - 1.0, 1.0);
+		table_samples = std::ceil(PI_FIR * std::sqrt(curvature)
+			/ (4.0 * std::sqrt(_error_max)));
+		if (fmod(table_samples, 2.0) != 0.0) { table_samples += 1.0; }
+		table_samples += 1.0;
+	}
+	if (_lookup == wvt_lookup::direct) { table_samples = 1.0; }
 	if (!Valid_Table_Size_Cast(table_samples))
 	{
 		throw accuracy_error(
@@ -86,15 +137,21 @@ void wvt_win::Create_Wvt(double table_samples, long accu_check_samples)
 		throw accuracy_error(
 			"Invalid table size - resulting error greater than _error_max");
 	}
-	_wvt = std::vector<double>(static_cast<long>(table_samples), 0.0);
-	double table_index_max = table_samples - 1.0;
-	for (long sample = 0; sample < _wvt.size(); sample++)
+	if (_lookup == wvt_lookup::direct) { return; }
+	_wvt = wvt_registry::Acquire(
+		std::make_tuple(wvt_kind::win, table_samples, _pow),
+		[this, table_samples](std::vector<double>& wvt)
 	{
-		double sample_fp = sample;
-		double x = sample_fp / table_index_max;
-		double result = std::cos(0.5 * PI_FIR * x);
-		_wvt.at(sample) = Power(result, _pow);
-	}
+		wvt.assign(static_cast<long>(table_samples), 0.0);
+		double table_index_max = table_samples - 1.0;
+		for (long sample = 0; sample < wvt.size(); sample++)
+		{
+			double sample_fp = sample;
+			double x = sample_fp / table_index_max;
+			double result = std::cos(0.5 * PI_FIR * x);
+			wvt.at(sample) = Power(result, _pow);
+		}
+	});
 
 	return;
 }
@@ -18,8 +18,12 @@ public:
 
 public:
 	void Configure(double samplerate, double error_max, double pow);
+	void Configure(double samplerate, double error_max, double pow,
+		wvt_lookup lookup);
 	std::vector<double> Get_Causal_Window(
 		std::vector<double>::size_type total_samples);
+	void Get_Causal_Window(std::vector<double>::size_type total_samples,
+		std::vector<double>& window);
 
 private:
 	double Determine_Samples_To_Allocate() const override;
@@ -0,0 +1,90 @@
+// Heterodyne mode against the per sample responses
+//
+// A band-pass and a band-elimination filter with a fixed bandwidth filter
+// noise in [-1.0, 1.0] with heterodyne mode on and off. With a constant
+// centre frequency the heterodyne output must stay within error_max of
+// the per sample responses. A 2 to 8 kHz centre sweep, which the mixers
+// cannot follow within error_max, must give the per sample output.
+//
+//	g++ -std=c++14 -O2 -I../src ../src/*.cpp heterodyne_test.cpp -lpthread
+
+#include <algorithm>	// std::max
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "firf_be_tmp.h"
+#include "firf_bp_tmp.h"
+
+namespace
+{
+	double const samplerate = 48000.0;
+	long const samples = 20000;
+
+	double Max_Diff(std::vector<double> const& first,
+		std::vector<double> const& second)
+	{
+		// Prom: largest absolute difference, infinity for other sizes
+		if (first.size() != second.size()) { return HUGE_VAL; }
+		double diff = 0.0;
+		for (std::size_t index = 0; index < first.size(); index++)
+		{
+			diff = std::max(diff, std::abs(first[index] - second[index]));
+		}
+
+		return diff;
+	}
+
+	template <class filter>
+	int Check(char const* name, double error_max,
+		std::vector<double> const& signal)
+	{
+		// Prom: number of outputs beyond error_max of the per sample ones
+		int failures = 0;
+		std::vector<double> sweep(samples);
+		for (long sample = 0; sample < samples; sample++)
+		{
+			sweep[sample] = 2000.0 + 6000.0 * sample / (samples - 1);
+		}
+		std::vector<double> centre(1, 5000.0);
+		std::vector<double> bandwidth(1, 400.0);
+		std::vector<double> atten(1, 1.0);
+		for (auto const* freq_center : { &centre, &sweep })
+		{
+			filter firf(samplerate, error_max, 400.0, 2.0, 0.5);
+			firf.Set_Parameters(freq_center, &bandwidth, &atten);
+			std::vector<double> reference = firf.Filter(signal);
+			firf.Set_Heterodyne(true);
+			double diff = Max_Diff(firf.Filter(signal), reference);
+			char const* kind = (freq_center == &centre) ? "constant"
+				: "sweep";
+			std::printf("%s %s error_max %g: difference %.3g\n", name, kind,
+				error_max, diff);
+			if (!(diff <= error_max))
+			{
+				std::printf("FAIL: %s %s beyond error_max\n", name, kind);
+				failures++;
+			}
+		}
+
+		return failures;
+	}
+}
+
+int main()
+{
+	int failures = 0;
+	std::mt19937_64 generator(18);
+	std::uniform_real_distribution<double> sample_dist(-1.0, 1.0);
+	std::vector<double> signal(samples);
+	for (auto& sample : signal) { sample = sample_dist(generator); }
+	for (double error_max : { 1e-2, 1e-4 })
+	{
+		failures += Check<firf_bp_tmp>("bp", error_max, signal);
+		failures += Check<firf_be_tmp>("be", error_max, signal);
+	}
+	if (failures == 0) { std::printf("PASS: heterodyne mode\n"); }
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// Neumaier normalization against the sorted Kahan summation it replaced
+//
+// firf_base::Sum_Abs_Neumaier(...) sums the absolute taps in four
+// interleaved Neumaier accumulators without sorting. The reference is the
+// previous Normalize_Abs_Kahan(...) sum: the absolute values sorted
+// ascending and Kahan summed. Both sums are within 2e of the exact sum, so
+// they may differ by 4e relative, and the taps normalized by the Neumaier
+// sum must sum to 1 within the normalization share Error_Imp_Resp(...)
+// reserves, 4en + 2e for n taps. Vectors of up to 20000 taps hold
+// magnitudes spread over 30 decades with random signs.
+//
+//	g++ -std=c++14 -O2 -I../src ../src/*.cpp neumaier_test.cpp -lpthread
+
+#include <algorithm>	// std::sort
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "firf_base.h"
+
+namespace
+{
+	class firf_sum : public firf_base
+	{
+	public:
+		using firf_base::Normalize_Abs_Neumaier;
+		using firf_base::Sum_Abs_Neumaier;
+		using firf_base::Error_Imp_Resp;
+
+		std::vector<double> Filter(std::vector<double> const& signal)
+			override
+		{
+			return signal;
+		}
+
+		void Filter(double const*, long, double*, long) override
+		{
+			return;
+		}
+
+	protected:
+		void Set_Imp_Resp() override
+		{
+			return;
+		}
+	};
+
+	double Sum_Abs_Sorted_Kahan(std::vector<double> const& vtr_to_sum)
+	{
+		// Prom: the summation of the previous Normalize_Abs_Kahan(...)
+		std::vector<double> abs_sorted(vtr_to_sum);
+		for (auto& element : abs_sorted) { element = std::abs(element); }
+		std::sort(abs_sorted.begin(), abs_sorted.end());
+		double sum = 0.0;
+		double c = 0.0;
+		for (auto const& element : abs_sorted)
+		{
+			double y = element - c;
+			double t = sum + y;
+			c = (t - sum) - y;
+			sum = t;
+		}
+
+		return sum;
+	}
+}
+
+int main()
+{
+	int failures = 0;
+	firf_sum summer;
+	std::mt19937_64 generator(16);
+	std::uniform_int_distribution<long> size_dist(1, 20000);
+	std::uniform_real_distribution<double> exponent_dist(-30.0, 0.0);
+	std::uniform_real_distribution<double> sign_dist(-1.0, 1.0);
+	double sum_diff_max = 0.0;
+	double norm_diff_max = 0.0;
+	for (long trial = 0; trial < 2000; trial++)
+	{
+		long size = size_dist(generator);
+		std::vector<double> taps(size);
+		for (auto& tap : taps)
+		{
+			double sign = sign_dist(generator) < 0.0 ? -1.0 : 1.0;
+			tap = sign * std::pow(10.0, exponent_dist(generator));
+		}
+		double reference = Sum_Abs_Sorted_Kahan(taps);
+		double sum = summer.Sum_Abs_Neumaier(taps);
+		double sum_diff = std::abs(sum - reference) / reference;
+		summer.Normalize_Abs_Neumaier(taps);
+		double norm_diff = std::abs(Sum_Abs_Sorted_Kahan(taps) - 1.0);
+		double norm_bound = 1.0 - summer.Error_Imp_Resp(size, 1.0);
+		sum_diff_max = std::max(sum_diff_max, sum_diff);
+		norm_diff_max = std::max(norm_diff_max, norm_diff);
+		if (sum_diff > 4.0 * DBL_EPSILON || norm_diff > norm_bound)
+		{
+			std::printf("FAIL: %ld taps, sum %.3g, normalized %.3g\n", size,
+				sum_diff, norm_diff);
+			failures++;
+		}
+	}
+	std::printf("largest relative sum difference %.3g, normalized sum "
+		"difference %.3g\n", sum_diff_max, norm_diff_max);
+	if (failures == 0) { std::printf("PASS: Neumaier summation\n"); }
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// Block streaming against one Filter(...) call
+//
+// Streams noise in [-1.0, 1.0] through Process_Block(...) in blocks of
+// random size and Flush(), and compares the concatenated output with one
+// Filter(...) call on the whole signal. Below Get_Fft_Threshold() taps
+// Filter(...) uses the direct form like the stream and the outputs must be
+// identical, from the threshold on it uses the fft engine and they must
+// agree within error_max. Filter(...) and the partition setters between
+// the blocks of a stream must throw config_error and leave the stream and
+// its output untouched.
+//
+//	g++ -std=c++14 -O2 -I../src ../src/*.cpp stream_test.cpp -lpthread
+
+#include <algorithm>	// std::max, std::min
+#include <climits>		// LONG_MAX
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "errors_custom.h"
+#include "firf_lp.h"
+
+namespace
+{
+	double const samplerate = 48000.0;
+	double const error_max = 1e-4;
+	long const samples = 20000;
+
+	std::vector<double> Stream(firf_lp& firf,
+		std::vector<double> const& signal, std::mt19937_64& generator)
+	{
+		// Prom: blocks of 1 to 1000 samples followed by the flushed tail
+		std::uniform_int_distribution<long> block_dist(1, 1000);
+		std::vector<double> streamed;
+		std::vector<double> filtered_block;
+		long sample = 0;
+		while (sample < static_cast<long>(signal.size()))
+		{
+			long block_size = std::min(block_dist(generator),
+				static_cast<long>(signal.size()) - sample);
+			std::vector<double> block(signal.begin() + sample,
+				signal.begin() + sample + block_size);
+			firf.Process_Block(block, filtered_block);
+			streamed.insert(streamed.end(), filtered_block.begin(),
+				filtered_block.end());
+			sample += block_size;
+		}
+		std::vector<double> tail = firf.Flush();
+		streamed.insert(streamed.end(), tail.begin(), tail.end());
+
+		return streamed;
+	}
+
+	double Max_Diff(std::vector<double> const& first,
+		std::vector<double> const& second)
+	{
+		// Prom: largest absolute difference, infinity for other sizes
+		if (first.size() != second.size()) { return HUGE_VAL; }
+		double diff = 0.0;
+		for (std::size_t index = 0; index < first.size(); index++)
+		{
+			diff = std::max(diff, std::abs(first[index] - second[index]));
+		}
+
+		return diff;
+	}
+}
+
+int main()
+{
+	int failures = 0;
+	std::mt19937_64 generator(6);
+	std::uniform_real_distribution<double> sample_dist(-1.0, 1.0);
+	std::vector<double> signal(samples);
+	for (auto& sample : signal) { sample = sample_dist(generator); }
+
+	// 23 taps stay below the default threshold, 179 taps reach it
+	struct stream_case { double freq_min; long threshold; };
+	for (auto const& test : { stream_case{ 3000.0, 0 },
+		stream_case{ 400.0, 0 }, stream_case{ 400.0, LONG_MAX } })
+	{
+		firf_lp firf(samplerate, error_max, test.freq_min, 2.0, 0.5);
+		firf.Set_Parameters(test.freq_min, 1.0);
+		if (test.threshold > 0) { firf.Set_Fft_Threshold(test.threshold); }
+		long taps = firf.Get_Filtered_Signal_Size(0) + 1;
+		bool fft = taps >= firf.Get_Fft_Threshold();
+		double diff = Max_Diff(Stream(firf, signal, generator),
+			firf.Filter(signal));
+		std::printf("%ld taps, %s: difference %.3g\n", taps,
+			fft ? "fft" : "direct", diff);
+		if ((fft && !(diff <= error_max)) || (!fft && diff != 0.0))
+		{
+			std::printf("FAIL: %ld taps, stream differs from Filter(...)\n",
+				taps);
+			failures++;
+		}
+	}
+
+	// One-shot filtering and engine changes interleaved with a stream
+	firf_lp firf(samplerate, error_max, 3000.0, 2.0, 0.5);
+	firf.Set_Parameters(3000.0, 1.0);
+	std::vector<double> reference = firf.Filter(signal);
+	std::vector<double> streamed;
+	std::vector<double> filtered_block;
+	std::vector<double> half_signal(signal.begin(), signal.begin()
+		+ samples / 2);
+	int rejected = 0;
+	for (long block = 0; block < 2; block++)
+	{
+		std::vector<double> half(signal.begin() + block * samples / 2,
+			signal.begin() + (block + 1) * samples / 2);
+		firf.Process_Block(half, filtered_block);
+		streamed.insert(streamed.end(), filtered_block.begin(),
+			filtered_block.end());
+		try { firf.Filter(half_signal); }
+		catch (config_error const&) { rejected++; }
+		try { firf.Set_Partition_Size(64); }
+		catch (config_error const&) { rejected++; }
+		try { firf.Set_Hybrid_Partition_Size(64); }
+		catch (config_error const&) { rejected++; }
+	}
+	std::vector<double> tail = firf.Flush();
+	streamed.insert(streamed.end(), tail.begin(), tail.end());
+	double diff = Max_Diff(streamed, reference);
+	std::printf("interleaved: %d of 6 calls rejected, difference %.3g\n",
+		rejected, diff);
+	if (rejected != 6 || diff != 0.0
+		|| Max_Diff(firf.Filter(signal), reference) != 0.0)
+	{
+		std::printf("FAIL: Filter(...) interleaved with a stream\n");
+		failures++;
+	}
+	if (failures == 0) { std::printf("PASS: block streaming\n"); }
+
+	return failures == 0 ? 0 : 1;
+}
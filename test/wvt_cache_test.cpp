@@ -0,0 +1,136 @@
+// Reuse of the wavetable cache files of every wvt_kind
+//
+// Builds a cos, sinc and window table with a cache directory, frees them
+// and builds them again. A reused file keeps its inode, a rejected one is
+// rewritten through a renamed temporary file and gets a new inode. The
+// second tables, read from the files, must give the same output as tables
+// synthesized without a cache.
+//
+//	g++ -std=c++14 -O2 -I../src ../src/*.cpp wvt_cache_test.cpp -lpthread
+
+#include <cstdio>
+#include <cstdlib>		// mkdtemp
+#include <string>
+#include <vector>
+
+#include <dirent.h>		// opendir, readdir
+#include <sys/stat.h>	// stat
+#include <unistd.h>		// rmdir, unlink
+
+#include "wvt_cos.h"
+#include "wvt_registry.h"
+#include "wvt_sinc.h"
+#include "wvt_win.h"
+
+namespace
+{
+	double const samplerate = 48000.0;
+	double const error_max = 1e-4;
+	long const samples = 4096;
+
+	std::vector<double> Tables_Output()
+	{
+		// Prom: output of a cos, sinc and window table, each table freed
+		// on return
+		wvt_cos cos_wvt(samplerate, error_max, samples);
+		wvt_sinc sinc_wvt(samplerate, error_max, samples);
+		wvt_win win_wvt(samplerate, error_max, 2.0);
+		std::vector<double> output = cos_wvt.Get_Causal_Cos(1234.5,
+			samples);
+		std::vector<double> sinc = sinc_wvt.Get_Causal_Sinc_Rev(1234.5,
+			samples);
+		std::vector<double> win = win_wvt.Get_Causal_Window(samples);
+		output.insert(output.end(), sinc.begin(), sinc.end());
+		output.insert(output.end(), win.begin(), win.end());
+
+		return output;
+	}
+
+	std::vector<std::string> Cache_Files(std::string const& directory)
+	{
+		std::vector<std::string> files;
+		DIR* dir = opendir(directory.c_str());
+		if (dir == nullptr) { return files; }
+		while (dirent* entry = readdir(dir))
+		{
+			std::string name = entry->d_name;
+			if (name != "." && name != "..")
+			{
+				files.push_back(directory + "/" + name);
+			}
+		}
+		closedir(dir);
+
+		return files;
+	}
+
+	bool Has_Kind(std::vector<std::string> const& files, char const* kind)
+	{
+		std::string prefix = std::string("/wvt_") + kind + "_";
+		for (auto const& file : files)
+		{
+			if (file.find(prefix) != std::string::npos) { return true; }
+		}
+
+		return false;
+	}
+
+	long Inode(std::string const& file)
+	{
+		struct stat status;
+		if (stat(file.c_str(), &status) != 0) { return -1; }
+
+		return static_cast<long>(status.st_ino);
+	}
+}
+
+int main()
+{
+	int failures = 0;
+	std::vector<double> reference = Tables_Output();
+	char directory_template[] = "/tmp/wvt_cache_test_XXXXXX";
+	if (mkdtemp(directory_template) == nullptr)
+	{
+		std::printf("FAIL: no temporary directory\n");
+		return 1;
+	}
+	std::string directory = directory_template;
+	wvt_registry::Set_Cache_Directory(directory);
+
+	// First run synthesizes and writes the files
+	std::vector<double> first = Tables_Output();
+	std::vector<std::string> files = Cache_Files(directory);
+	for (char const* kind : { "cos", "sinc", "win" })
+	{
+		if (!Has_Kind(files, kind))
+		{
+			std::printf("FAIL: no %s cache file\n", kind);
+			failures++;
+		}
+	}
+	std::vector<long> inodes;
+	for (auto const& file : files) { inodes.push_back(Inode(file)); }
+
+	// Second run maps the files, none may be rewritten
+	std::vector<double> second = Tables_Output();
+	for (std::size_t index = 0; index < files.size(); index++)
+	{
+		if (Inode(files[index]) != inodes[index])
+		{
+			std::printf("FAIL: %s rewritten\n", files[index].c_str());
+			failures++;
+		}
+	}
+	if (first != reference || second != reference)
+	{
+		std::printf("FAIL: cached tables differ from synthesized tables\n");
+		failures++;
+	}
+
+	wvt_registry::Set_Cache_Directory("");
+	for (auto const& file : Cache_Files(directory)) { unlink(file.c_str()); }
+	rmdir(directory.c_str());
+	if (failures == 0) { std::printf("PASS: wvt cache reuse\n"); }
+
+	return failures == 0 ? 0 : 1;
+}